@@ -72,20 +72,23 @@ CSRCS = \
 	../module/preset_r_mode.c   				\
 	../module/preset_w_mode.c   				\
 	../module/usb_disk_mode.c   				\
+	../src/bytecode.c					\
 	../src/command.c					\
 	../src/helpers.c					\
+	../src/ii_bus.c					\
 	../src/match_token.c					\
 	../src/scanner.c					\
 	../src/state.c						\
 	../src/table.c						\
 	../src/teletype.c					\
 	../src/ops/op.c						\
+	../src/ops/op_table.c					\
 	../src/ops/ansible.c					\
 	../src/ops/controlflow.c				\
 	../src/ops/delay.c					\
 	../src/ops/earthsea.c					\
 	../src/ops/hardware.c					\
-	../src/ops/justfriends.c				\
+	../src/ops/ii_ops.c					\
 	../src/ops/maths.c					\
 	../src/ops/meadowphysics.c				\
 	../src/ops/metronome.c					\
@@ -223,7 +226,8 @@ CFLAGS = -fshort-enums -fno-common
 # The most relevant symbols to define for the preprocessor are:
 #   BOARD      Target board in use, see boards/board.h for a list.
 #   EXT_BOARD  Optional extension board in use, see boards/board.h for a list.
-CPPFLAGS = -D BOARD=USER_BOARD -D UHD_ENABLE
+#   TELE_THREADED_DISPATCH  Use computed goto in the script executor.
+CPPFLAGS = -D BOARD=USER_BOARD -D UHD_ENABLE -D TELE_THREADED_DISPATCH
 
 # Extra flags to use when linking
 LDFLAGS = -Wl,-e,_trampoline
@@ -7,9 +7,120 @@
 #include "print_funcs.h"
 
 // this
+#include "ops/op_enum.h"
 #include "teletype.h"
 
-#define FIRSTRUN_KEY 0x22
+#define FIRSTRUN_KEY 0x23
+#define PATTERN_BANKS_KEY 0x24
+
+// Scenes saved before command words were packed (see tele_command_t) have
+// this key, and are converted to the new layout the first time this version
+// runs, rather than being cleared. The old layout is kept here, tele_word_t
+// was an enum, so a single byte with -fshort-enums.
+#define FIRSTRUN_KEY_V1 0x22
+
+typedef struct {
+    uint8_t tag;
+    int16_t value;
+} v1_data_t;
+
+typedef struct {
+    uint8_t length;
+    int8_t separator;
+    v1_data_t data[COMMAND_MAX_LENGTH];
+} v1_command_t;
+
+typedef struct {
+    uint8_t l;
+    v1_command_t c[SCRIPT_MAX_COMMANDS];
+} v1_script_t;
+
+typedef const struct {
+    v1_script_t scripts[SCRIPT_COUNT];
+    scene_pattern_t patterns[PATTERN_COUNT];
+    char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+} v1_scene_t;
+
+typedef const struct {
+    v1_scene_t scenes[SCENE_SLOTS];
+    uint8_t last_scene;
+    uint8_t fresh;
+} v1_nvram_data_t;
+
+// ops have been added since, so the op numbers stored by the old version are
+// looked up here, in the order of its tele_op_idx_t
+static const uint16_t v1_ops[] = {
+    E_OP_A, E_OP_B, E_OP_C, E_OP_D, E_OP_DRUNK, E_OP_DRUNK_MAX, E_OP_DRUNK_MIN,
+    E_OP_DRUNK_WRAP, E_OP_FLIP, E_OP_I, E_OP_O, E_OP_O_INC, E_OP_O_MAX,
+    E_OP_O_MIN, E_OP_O_WRAP, E_OP_T, E_OP_TIME, E_OP_TIME_ACT, E_OP_X, E_OP_Y,
+    E_OP_Z, E_OP_M, E_OP_M_SYM_EXCLAMATION, E_OP_M_ACT, E_OP_M_RESET, E_OP_P_N,
+    E_OP_P, E_OP_PN, E_OP_P_L, E_OP_PN_L, E_OP_P_WRAP, E_OP_PN_WRAP,
+    E_OP_P_START, E_OP_PN_START, E_OP_P_END, E_OP_PN_END, E_OP_P_I, E_OP_PN_I,
+    E_OP_P_HERE, E_OP_PN_HERE, E_OP_P_NEXT, E_OP_PN_NEXT, E_OP_P_PREV,
+    E_OP_PN_PREV, E_OP_P_INS, E_OP_PN_INS, E_OP_P_RM, E_OP_PN_RM, E_OP_P_PUSH,
+    E_OP_PN_PUSH, E_OP_P_POP, E_OP_PN_POP, E_OP_Q, E_OP_Q_AVG, E_OP_Q_N,
+    E_OP_CV, E_OP_CV_OFF, E_OP_CV_SLEW, E_OP_IN, E_OP_PARAM, E_OP_PRM, E_OP_TR,
+    E_OP_TR_POL, E_OP_TR_TIME, E_OP_TR_TOG, E_OP_TR_PULSE, E_OP_TR_P,
+    E_OP_CV_SET, E_OP_MUTE, E_OP_STATE, E_OP_ADD, E_OP_SUB, E_OP_MUL, E_OP_DIV,
+    E_OP_MOD, E_OP_RAND, E_OP_RRAND, E_OP_TOSS, E_OP_MIN, E_OP_MAX, E_OP_LIM,
+    E_OP_WRAP, E_OP_QT, E_OP_AVG, E_OP_EQ, E_OP_NE, E_OP_LT, E_OP_GT, E_OP_LTE,
+    E_OP_GTE, E_OP_NZ, E_OP_EZ, E_OP_RSH, E_OP_LSH, E_OP_EXP, E_OP_ABS,
+    E_OP_AND, E_OP_OR, E_OP_JI, E_OP_SCALE, E_OP_N, E_OP_V, E_OP_VV, E_OP_ER,
+    E_OP_XOR, E_OP_SYM_PLUS, E_OP_SYM_DASH, E_OP_SYM_STAR,
+    E_OP_SYM_FORWARD_SLASH, E_OP_SYM_PERCENTAGE, E_OP_SYM_EQUAL_x2,
+    E_OP_SYM_EXCLAMATION_EQUAL, E_OP_SYM_LEFT_ANGLED, E_OP_SYM_RIGHT_ANGLED,
+    E_OP_SYM_LEFT_ANGLED_EQUAL, E_OP_SYM_RIGHT_ANGLED_EQUAL,
+    E_OP_SYM_EXCLAMATION, E_OP_SYM_LEFT_ANGLED_x2, E_OP_SYM_RIGHT_ANGLED_x2,
+    E_OP_SYM_AMPERSAND_x2, E_OP_SYM_PIPE_x2, E_OP_S_ALL, E_OP_S_POP, E_OP_S_CLR,
+    E_OP_S_L, E_OP_SCRIPT, E_OP_KILL, E_OP_SCENE, E_OP_DEL_CLR, E_OP_WW_PRESET,
+    E_OP_WW_POS, E_OP_WW_SYNC, E_OP_WW_START, E_OP_WW_END, E_OP_WW_PMODE,
+    E_OP_WW_PATTERN, E_OP_WW_QPATTERN, E_OP_WW_MUTE1, E_OP_WW_MUTE2,
+    E_OP_WW_MUTE3, E_OP_WW_MUTE4, E_OP_WW_MUTEA, E_OP_WW_MUTEB, E_OP_MP_PRESET,
+    E_OP_MP_RESET, E_OP_MP_STOP, E_OP_ES_PRESET, E_OP_ES_MODE, E_OP_ES_CLOCK,
+    E_OP_ES_RESET, E_OP_ES_PATTERN, E_OP_ES_TRANS, E_OP_ES_STOP, E_OP_ES_TRIPLE,
+    E_OP_ES_MAGIC, E_OP_OR_TRK, E_OP_OR_CLK, E_OP_OR_DIV, E_OP_OR_PHASE,
+    E_OP_OR_RST, E_OP_OR_WGT, E_OP_OR_MUTE, E_OP_OR_SCALE, E_OP_OR_BANK,
+    E_OP_OR_PRESET, E_OP_OR_RELOAD, E_OP_OR_ROTS, E_OP_OR_ROTW, E_OP_OR_GRST,
+    E_OP_OR_CVA, E_OP_OR_CVB, E_OP_KR_PRE, E_OP_KR_PAT, E_OP_KR_SCALE,
+    E_OP_KR_PERIOD, E_OP_KR_POS, E_OP_KR_L_ST, E_OP_KR_L_LEN, E_OP_KR_RES,
+    E_OP_ME_PRE, E_OP_ME_RES, E_OP_ME_STOP, E_OP_ME_SCALE, E_OP_ME_PERIOD,
+    E_OP_LV_PRE, E_OP_LV_RES, E_OP_LV_POS, E_OP_LV_L_ST, E_OP_LV_L_LEN,
+    E_OP_LV_L_DIR, E_OP_LV_CV, E_OP_CY_PRE, E_OP_CY_RES, E_OP_CY_POS,
+    E_OP_CY_REV, E_OP_CY_CV, E_OP_MID_SHIFT, E_OP_MID_SLEW, E_OP_ARP_STY,
+    E_OP_ARP_HLD, E_OP_ARP_RPT, E_OP_ARP_GT, E_OP_ARP_DIV, E_OP_ARP_RES,
+    E_OP_ARP_SHIFT, E_OP_ARP_SLEW, E_OP_ARP_FIL, E_OP_ARP_ROT, E_OP_ARP_ER,
+    E_OP_JF_TR, E_OP_JF_RMODE, E_OP_JF_RUN, E_OP_JF_SHIFT, E_OP_JF_VTR,
+    E_OP_JF_MODE, E_OP_JF_TICK, E_OP_JF_VOX, E_OP_JF_NOTE, E_OP_JF_GOD,
+    E_OP_JF_TUNE, E_OP_JF_QT, E_OP_TO_TR, E_OP_TO_TR_TOG, E_OP_TO_TR_PULSE,
+    E_OP_TO_TR_TIME, E_OP_TO_TR_TIME_S, E_OP_TO_TR_TIME_M, E_OP_TO_TR_POL,
+    E_OP_TO_KILL, E_OP_TO_TR_PULSE_DIV, E_OP_TO_TR_PULSE_MUTE, E_OP_TO_TR_M_MUL,
+    E_OP_TO_M, E_OP_TO_M_S, E_OP_TO_M_M, E_OP_TO_M_BPM, E_OP_TO_M_ACT,
+    E_OP_TO_M_SYNC, E_OP_TO_M_COUNT, E_OP_TO_TR_M, E_OP_TO_TR_M_S,
+    E_OP_TO_TR_M_M, E_OP_TO_TR_M_BPM, E_OP_TO_TR_M_ACT, E_OP_TO_TR_M_SYNC,
+    E_OP_TO_TR_WIDTH, E_OP_TO_TR_M_COUNT, E_OP_TO_CV, E_OP_TO_CV_SLEW,
+    E_OP_TO_CV_SLEW_S, E_OP_TO_CV_SLEW_M, E_OP_TO_CV_SET, E_OP_TO_CV_OFF,
+    E_OP_TO_CV_QT, E_OP_TO_CV_QT_SET, E_OP_TO_CV_N, E_OP_TO_CV_N_SET,
+    E_OP_TO_CV_SCALE, E_OP_TO_CV_LOG, E_OP_TO_CV_INIT, E_OP_TO_TR_INIT,
+    E_OP_TO_INIT, E_OP_TO_TR_P, E_OP_TO_TR_P_DIV, E_OP_TO_TR_P_MUTE,
+    E_OP_TO_OSC, E_OP_TO_OSC_SET, E_OP_TO_OSC_QT, E_OP_TO_OSC_QT_SET,
+    E_OP_TO_OSC_FQ, E_OP_TO_OSC_FQ_SET, E_OP_TO_OSC_N, E_OP_TO_OSC_N_SET,
+    E_OP_TO_OSC_LFO, E_OP_TO_OSC_LFO_SET, E_OP_TO_OSC_WAVE, E_OP_TO_OSC_SYNC,
+    E_OP_TO_OSC_PHASE, E_OP_TO_OSC_WIDTH, E_OP_TO_OSC_RECT, E_OP_TO_OSC_SLEW,
+    E_OP_TO_OSC_SLEW_S, E_OP_TO_OSC_SLEW_M, E_OP_TO_OSC_SCALE, E_OP_TO_OSC_CYC,
+    E_OP_TO_OSC_CYC_S, E_OP_TO_OSC_CYC_M, E_OP_TO_OSC_CYC_SET,
+    E_OP_TO_OSC_CYC_S_SET, E_OP_TO_OSC_CYC_M_SET, E_OP_TO_OSC_CTR,
+    E_OP_TO_ENV_ACT, E_OP_TO_ENV_ATT, E_OP_TO_ENV_ATT_S, E_OP_TO_ENV_ATT_M,
+    E_OP_TO_ENV_DEC, E_OP_TO_ENV_DEC_S, E_OP_TO_ENV_DEC_M, E_OP_TO_ENV_TRIG,
+    E_OP_TO_ENV_EOR, E_OP_TO_ENV_EOC, E_OP_TO_ENV_LOOP, E_OP_TI_PARAM,
+    E_OP_TI_PARAM_QT, E_OP_TI_PARAM_N, E_OP_TI_PARAM_SCALE, E_OP_TI_PARAM_MAP,
+    E_OP_TI_IN, E_OP_TI_IN_QT, E_OP_TI_IN_N, E_OP_TI_IN_SCALE, E_OP_TI_IN_MAP,
+    E_OP_TI_PARAM_CALIB, E_OP_TI_IN_CALIB, E_OP_TI_STORE, E_OP_TI_RESET,
+    E_OP_TI_PARAM_INIT, E_OP_TI_IN_INIT, E_OP_TI_INIT, E_OP_TI_PRM,
+    E_OP_TI_PRM_QT, E_OP_TI_PRM_N, E_OP_TI_PRM_SCALE, E_OP_TI_PRM_MAP,
+    E_OP_TI_PRM_INIT,
+};
+
+#define V1_OP_COUNT (sizeof(v1_ops) / sizeof(v1_ops[0]))
 
 // NVRAM data structure located in the flash array.
 typedef const struct {
@@ -18,18 +129,137 @@ typedef const struct {
     char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
 } nvram_scene_t;
 
+// the scenes take less room than in the old layout, last_scene and fresh are
+// moved up to where they were in it, so that fresh says which layout the flash
+// is in, whichever it is
+#define V1_PADDING \
+    (SCENE_SLOTS * (sizeof(v1_scene_t) - sizeof(nvram_scene_t)))
+
 typedef const struct {
     nvram_scene_t scenes[SCENE_SLOTS];
+    uint8_t v1_padding[V1_PADDING];
     uint8_t last_scene;
     uint8_t fresh;
+    // the pattern banks were added after the rest, so that scenes saved before
+    // then are kept, bank 0 of each scene is nvram_scene_t.patterns
+    scene_pattern_t pattern_banks[SCENE_SLOTS][PATTERN_BANK_COUNT - 1]
+                                 [PATTERN_COUNT];
+    uint8_t pattern_banks_fresh;
 } nvram_data_t;
 
 static __attribute__((__section__(".flash_nvram"))) nvram_data_t f;
 
-void flash_prepare() {
-    // if it's not empty return
-    if (f.fresh == FIRSTRUN_KEY) return;
+// the scene whose pattern banks are being played (see flash_load_pattern_banks),
+// and a RAM copy of each bank that has been changed since, or NULL if it
+// hasn't, the selected bank is in scene_state so never has one
+static uint8_t banks_preset;
+static scene_pattern_t *bank_edits[PATTERN_BANK_COUNT];
+static scene_pattern_t bank_edit_pool[PATTERN_BANK_COUNT - 1][PATTERN_COUNT];
+
+static const scene_pattern_t *scene_pattern_bank(uint8_t preset_no,
+                                                 uint8_t bank) {
+    if (bank == 0) return f.scenes[preset_no].patterns;
+    return f.pattern_banks[preset_no][bank - 1];
+}
+
+// a scene is saved with all of its banks, so skip the write (and the wear on
+// the flash) for those that haven't changed
+static void write_patterns(const scene_pattern_t *dst,
+                           const scene_pattern_t *src) {
+    if (memcmp(dst, src, ss_patterns_size()) == 0) return;
+    flashc_memcpy((void *)dst, src, ss_patterns_size(), true);
+}
+
+static void flash_prepare_pattern_banks(bool clear) {
+    if (!clear && f.pattern_banks_fresh == PATTERN_BANKS_KEY) return;
+
+    print_dbg("\r\n:::: first run, clearing pattern banks");
+
+    scene_pattern_t patterns[PATTERN_COUNT];
+    ss_pattern_bank_init(patterns);
+
+    for (uint8_t i = 0; i < SCENE_SLOTS; i++) {
+        for (uint8_t b = 1; b < PATTERN_BANK_COUNT; b++)
+            flash_write_pattern_bank(i, b, patterns);
+    }
+    flashc_memset8((void *)&f.pattern_banks_fresh, PATTERN_BANKS_KEY, 1, true);
+}
+
+static bool convert_v1_command(const v1_command_t *old, tele_command_t *c) {
+    command_init(c);
+    if (old->length > COMMAND_MAX_LENGTH || old->separator >= old->length)
+        return false;
+
+    for (uint8_t i = 0; i < old->length; i++) {
+        const tele_word_t tag = old->data[i].tag;
+        int16_t value = old->data[i].value;
+        if (tag == OP) {
+            if (value < 0 || (size_t)value >= V1_OP_COUNT) return false;
+            value = v1_ops[value];
+        }
+        else if (tag == MOD) {
+            if (value < 0 || value >= E_MOD__LENGTH) return false;
+        }
+        else if (tag > SUB_SEP)
+            return false;
+
+        // every command the old version could parse fits (see
+        // COMMAND_MAX_WIDE)
+        if (!command_append(c, tag, value)) return false;
+    }
+
+    c->separator = old->separator;
+    return true;
+}
+
+// a line that can't be converted (which would mean the flash is corrupt) is
+// left blank, the rest of the scene is kept
+static void convert_v1_scene(uint8_t preset_no, v1_scene_t *old,
+                             scene_state_t *scene,
+                             char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
+    ss_init(scene);
+    scene_script_t *scripts = ss_scripts_ptr(scene);
+    for (uint8_t s = 0; s < SCRIPT_COUNT; s++) {
+        scripts[s].l = old->scripts[s].l;
+        if (scripts[s].l > SCRIPT_MAX_COMMANDS)
+            scripts[s].l = SCRIPT_MAX_COMMANDS;
+        for (uint8_t l = 0; l < scripts[s].l; l++) {
+            if (convert_v1_command(&old->scripts[s].c[l], &scripts[s].c[l]))
+                continue;
+            print_dbg("\r\ncan't convert scene: ");
+            print_dbg_ulong(preset_no);
+            print_dbg(" script: ");
+            print_dbg_ulong(s);
+            print_dbg(" line: ");
+            print_dbg_ulong(l);
+            command_init(&scripts[s].c[l]);
+        }
+    }
 
+    memcpy(ss_patterns_ptr(scene), old->patterns, ss_patterns_size());
+    memcpy(text, old->text, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+}
+
+// each scene takes less room in the new layout, so the new copy of a scene
+// only ever overwrites the old copies of that scene and those before it, as
+// long as they're converted in order
+static void convert_v1_scenes() {
+    v1_nvram_data_t *old = (v1_nvram_data_t *)&f;
+    const uint8_t last_scene = old->last_scene;
+
+    print_dbg("\r\n:::: first run, converting scenes");
+
+    scene_state_t scene;
+    char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+    for (uint8_t i = 0; i < SCENE_SLOTS; i++) {
+        convert_v1_scene(i, &old->scenes[i], &scene, &text);
+        flash_write(i, &scene, &text);
+    }
+
+    flash_update_last_saved_scene(last_scene < SCENE_SLOTS ? last_scene : 0);
+}
+
+static void clear_scenes() {
     print_dbg("\r\n:::: first run, clearing flash");
     print_dbg("\r\nflash size: ");
     print_dbg_ulong(sizeof(f));
@@ -43,15 +273,32 @@ void flash_prepare() {
 
     for (uint8_t i = 0; i < SCENE_SLOTS; i++) { flash_write(i, &scene, &text); }
     flash_update_last_saved_scene(0);
-    flashc_memset8((void *)&f.fresh, FIRSTRUN_KEY, 1, true);
+}
+
+void flash_prepare() {
+    if (f.fresh != FIRSTRUN_KEY) {
+        // at the same offset as v1_nvram_data_t.fresh (see V1_PADDING)
+        if (f.fresh == FIRSTRUN_KEY_V1)
+            convert_v1_scenes();
+        else
+            clear_scenes();
+        flashc_memset8((void *)&f.fresh, FIRSTRUN_KEY, 1, true);
+
+        // the pattern banks are where the old scenes were, so they need
+        // clearing too, whatever is there
+        flash_prepare_pattern_banks(true);
+        return;
+    }
+
+    flash_prepare_pattern_banks(false);
 }
 
 void flash_write(uint8_t preset_no, scene_state_t *scene,
                  char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
     flashc_memcpy((void *)&f.scenes[preset_no].scripts, ss_scripts_ptr(scene),
                   ss_scripts_size(), true);
-    flashc_memcpy((void *)&f.scenes[preset_no].patterns, ss_patterns_ptr(scene),
-                  ss_patterns_size(), true);
+    write_patterns(scene_pattern_bank(preset_no, ss_get_pattern_bank(scene)),
+                   ss_patterns_ptr(scene));
     flashc_memcpy((void *)&f.scenes[preset_no].text, text,
                   SCENE_TEXT_LINES * SCENE_TEXT_CHARS, true);
 }
@@ -60,8 +307,10 @@ void flash_read(uint8_t preset_no, scene_state_t *scene,
                 char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
     memcpy(ss_scripts_ptr(scene), &f.scenes[preset_no].scripts,
            ss_scripts_size());
+    ss_compile_scripts(scene);
     memcpy(ss_patterns_ptr(scene), &f.scenes[preset_no].patterns,
            ss_patterns_size());
+    ss_set_pattern_bank(scene, 0);
     memcpy(text, &f.scenes[preset_no].text,
            SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
 }
@@ -77,3 +326,76 @@ void flash_update_last_saved_scene(uint8_t preset_no) {
 const char *flash_scene_text(uint8_t preset_no, size_t line) {
     return f.scenes[preset_no].text[line];
 }
+
+void flash_read_pattern_bank(uint8_t preset_no, uint8_t bank,
+                             scene_pattern_t *patterns) {
+    memcpy(patterns, scene_pattern_bank(preset_no, bank), ss_patterns_size());
+}
+
+void flash_write_pattern_bank(uint8_t preset_no, uint8_t bank,
+                              const scene_pattern_t *patterns) {
+    write_patterns(scene_pattern_bank(preset_no, bank), patterns);
+}
+
+void flash_load_pattern_banks(uint8_t preset_no) {
+    banks_preset = preset_no;
+    for (uint8_t b = 0; b < PATTERN_BANK_COUNT; b++) bank_edits[b] = NULL;
+}
+
+// a bank that isn't in use, there is always one for the bank being swapped
+// out, as neither it nor the one being swapped in has one
+static scene_pattern_t *free_bank_edit() {
+    for (uint8_t i = 0; i < PATTERN_BANK_COUNT - 1; i++) {
+        bool used = false;
+        for (uint8_t b = 0; b < PATTERN_BANK_COUNT; b++)
+            used |= bank_edits[b] == bank_edit_pool[i];
+        if (!used) return bank_edit_pool[i];
+    }
+    return NULL;
+}
+
+static void swap_patterns(scene_pattern_t *a, scene_pattern_t *b) {
+    uint8_t *x = (uint8_t *)a;
+    uint8_t *y = (uint8_t *)b;
+    for (size_t i = 0; i < ss_patterns_size(); i++) {
+        const uint8_t t = x[i];
+        x[i] = y[i];
+        y[i] = t;
+    }
+}
+
+void flash_swap_pattern_bank(uint8_t out, uint8_t in,
+                             scene_pattern_t *patterns) {
+    scene_pattern_t *edit = bank_edits[in];
+    bank_edits[in] = NULL;
+
+    if (memcmp(patterns, scene_pattern_bank(banks_preset, out),
+               ss_patterns_size()) == 0) {
+        memcpy(patterns, edit ? edit : scene_pattern_bank(banks_preset, in),
+               ss_patterns_size());
+        return;
+    }
+
+    // out has changed, so it takes over the RAM copy of in
+    if (edit) {
+        swap_patterns(edit, patterns);
+        bank_edits[out] = edit;
+        return;
+    }
+
+    edit = free_bank_edit();
+    memcpy(edit, patterns, ss_patterns_size());
+    bank_edits[out] = edit;
+    memcpy(patterns, scene_pattern_bank(banks_preset, in), ss_patterns_size());
+}
+
+void flash_save_pattern_banks(uint8_t preset_no, uint8_t selected_bank) {
+    for (uint8_t b = 0; b < PATTERN_BANK_COUNT; b++) {
+        if (b == selected_bank) continue;
+        // copied over from the scene being played if saving it somewhere else
+        const scene_pattern_t *patterns = bank_edits[b];
+        if (!patterns) patterns = scene_pattern_bank(banks_preset, b);
+        flash_write_pattern_bank(preset_no, b, patterns);
+    }
+    flash_load_pattern_banks(preset_no);
+}
@@ -18,4 +18,22 @@ uint8_t flash_last_saved_scene(void);
 void flash_update_last_saved_scene(uint8_t preset_no);
 const char *flash_scene_text(uint8_t preset_no, size_t line);
 
+// flash_read and flash_write only cover the selected pattern bank (always
+// bank 0 after a read), these cover the rest
+void flash_read_pattern_bank(uint8_t preset_no, uint8_t bank,
+                             scene_pattern_t *patterns);
+void flash_write_pattern_bank(uint8_t preset_no, uint8_t bank,
+                              const scene_pattern_t *patterns);
+
+// the pattern banks of the scene being played are read straight from flash,
+// until they're changed, from then until the scene is saved they're kept in
+// RAM, flash_load_pattern_banks starts again from a saved scene (once it has
+// been read), flash_swap_pattern_bank swaps bank in for bank out, which is in
+// patterns, and flash_save_pattern_banks saves every bank but the selected
+// one, as flash_write does that from scene_state
+void flash_load_pattern_banks(uint8_t preset_no);
+void flash_swap_pattern_bank(uint8_t out, uint8_t in,
+                             scene_pattern_t *patterns);
+void flash_save_pattern_banks(uint8_t preset_no, uint8_t selected_bank);
+
 #endif
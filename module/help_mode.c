@@ -57,7 +57,7 @@ const char* help1[HELP1_LENGTH] = { "1/8 HELP",
                                     "SH-E|SET END",
                                     "ALT-L,S,E|JUMP" };
 
-#define HELP2_LENGTH 13
+#define HELP2_LENGTH 15
 const char* help2[HELP2_LENGTH] = {
     "2/8 VARIABLES",           " ",
     "X, Y, Z|GENERAL PURPOSE", "T|USE FOR TIME",
@@ -65,10 +65,11 @@ const char* help2[HELP2_LENGTH] = {
     "// SPECIAL VARIABLES",    "I|USED BY LOOP",
     "O|INCREMENTS ON READ",    "DRUNK|INC BY -1, 0, +1",
     "Q|SHIFT REGISTER",        "Q.N|SET Q LENGTH",
-    "Q.AVG|AVERAGE OF ALL Q"
+    "Q.AVG|AVERAGE OF ALL Q",  "Q.MIN|SMALLEST IN Q",
+    "Q.MAX|LARGEST IN Q"
 };
 
-#define HELP3_LENGTH 20
+#define HELP3_LENGTH 26
 const char* help3[HELP3_LENGTH] = { "3/8 PARAMETERS",
                                     " ",
                                     "TR A-D|SET TR VALUE (0,1)",
@@ -84,6 +85,12 @@ const char* help3[HELP3_LENGTH] = { "3/8 PARAMETERS",
                                     "M|METRO TIME (MS)",
                                     "M.ACT|ENABLE METRO (0/1)",
                                     "M.RESET|HARD RESET TIMER",
+                                    "M.LATE|MOST MS METRO LATE",
+                                    "M.POL|MISSED: SKIP/RUN/SLOW",
+                                    "M.OVER|MISSED METRO TICKS",
+                                    "M.LOAD|METRO LOAD (%)",
+                                    "M1-M4|MORE METROS",
+                                    "M1.SCRIPT|SCRIPT RUN BY M1",
                                     " ",
                                     "TIME|TIMER COUNT (MS)",
                                     "TIME.ACT|ENABLE TIMER (0/1)",
@@ -162,15 +169,16 @@ const char* help6[HELP6_LENGTH] = { "6/8 PRE :",
                                     "L A B :|ITERATE FROM A-B",
                                     "NB: I IS UPDATED EACH TIME" };
 
-#define HELP7_LENGTH 26
+#define HELP7_LENGTH 39
 const char* help7[HELP7_LENGTH] = { "7/8 PATTERNS",
                                     " ",
                                     "// DIRECT ACCESS",
                                     "P A|GET VAL AT INDEX A",
                                     "P A B|SET VAL AT A TO B",
-                                    "P.N A|SELECT BANK A",
-                                    "PN A B|GET BANK A, IDX B",
-                                    "PN A B C|BANK A, IDX B TO C",
+                                    "P.N A|SELECT PATTERN A",
+                                    "PN A B|GET PAT A, IDX B",
+                                    "PN A B C|PAT A, IDX B TO C",
+                                    "P.BANK A|SELECT BANK A",
                                     " ",
                                     "// CHANGES LENGTH",
                                     "P.INS A B|INSERT B AT IDX A",
@@ -188,9 +196,21 @@ const char* help7[HELP7_LENGTH] = { "7/8 PATTERNS",
                                     "P.I A|GET/SET POSITION",
                                     "P.HERE A|GET/SET VAL AT P.I",
                                     "P.NEXT A|GET/SET NEXT POS",
-                                    "P.PREV A|GET/SET PREV POS" };
+                                    "P.PREV A|GET/SET PREV POS",
+                                    " ",
+                                    "// WHOLE PATTERN",
+                                    "P.REV|REVERSE",
+                                    "P.ROT A|ROTATE A STEPS",
+                                    "P.SHUF|SHUFFLE",
+                                    "P.ADD A|ADD A TO EACH",
+                                    "P.SCALE A B C D|SCALE EACH",
+                                    "P.SUM|SUM OF VALUES",
+                                    "P.MIN|LOWEST VALUE",
+                                    "P.MAX|HIGHEST VALUE",
+                                    "P.FIND A|INDEX OF A OR -1",
+                                    "PN.REV A ETC|FOR PATTERN A" };
 
-#define HELP8_LENGTH 42
+#define HELP8_LENGTH 48
 const char* help8[HELP8_LENGTH] = { "8/8 REMOTE",
                                     " ",
                                     "REMOTE CONTROL OF MONOME",
@@ -198,6 +218,12 @@ const char* help8[HELP8_LENGTH] = { "8/8 REMOTE",
                                     " ",
                                     "ALL MESSAGES NEED A VALUE",
                                     " ",
+                                    "WRITES ARE SENT AT SCRIPT END",
+                                    "II.FLUSH|SEND THEM NOW",
+                                    "INPUTS CAN BE READ IN BACKGROUND",
+                                    "II.POLL A|EVERY A MS, 0: OFF",
+                                    "II.REFRESH|READ THEM NOW",
+                                    " ",
                                     "// WHITE WHALE",
                                     "WW.PRESET|RECALL PRESET",
                                     "WW.POS|CUT TO POSITION",
@@ -45,6 +45,8 @@ static const uint8_t A_STACK = 1 << 3;
 static const uint8_t A_MUTES = 1 << 4;
 static uint8_t activity_prev;
 static uint8_t activity;
+static uint8_t metro_load_prev;
+static uint8_t metro_load;  // 0 to 5, the number of pixels lit in the icon
 
 // teletype_io.h
 void tele_has_delays(bool has_delays) {
@@ -80,6 +82,11 @@ void set_metro_icon(bool display) {
         activity &= ~A_METRO;
 }
 
+void set_metro_load_icon(uint8_t load) {
+    // a pixel for every 20%, any load at all lights one
+    metro_load = load >= 100 ? 5 : (load + 19) / 20;
+}
+
 // main mode functions
 void init_live_mode() {
     status = E_OK;
@@ -211,7 +218,7 @@ bool screen_refresh_live() {
         dirty &= ~D_LIST;
     }
 
-    if ((activity != activity_prev)) {
+    if (activity != activity_prev || metro_load != metro_load_prev) {
         region_fill(&line[0], 0);
 
         // slew icon
@@ -256,6 +263,12 @@ bool screen_refresh_live() {
         line[0].data[114 + 3 + 512] = stack_fg;
         line[0].data[114 + 4 + 512] = stack_fg;
 
+        // metro load icon, a bar filling from the bottom
+        for (uint8_t i = 0; i < 5; i++) {
+            uint8_t load_fg = i < metro_load ? 15 : 1;
+            line[0].data[120 + 512 - i * 128] = load_fg;
+        }
+
         // metro icon
         uint8_t metro_fg = activity & A_METRO ? 15 : 1;
         line[0].data[122 + 0 + 0] = metro_fg;
@@ -281,6 +294,7 @@ bool screen_refresh_live() {
         }
 
         activity_prev = activity;
+        metro_load_prev = metro_load;
         screen_dirty = true;
         activity &= ~A_MUTES;
     }
@@ -6,6 +6,8 @@
 
 void set_slew_icon(bool display);
 void set_metro_icon(bool display);
+// load is a %, see ss_get_metro_load
+void set_metro_load_icon(uint8_t load);
 void init_live_mode(void);
 void set_live_mode(void);
 void process_live_keys(uint8_t key, uint8_t mod_key, bool is_held_key);
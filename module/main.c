@@ -4,6 +4,7 @@
 
 // asf
 #include "compiler.h"
+#include "cycle_counter.h"
 #include "delay.h"
 #include "gpio.h"
 #include "intc.h"
@@ -47,7 +48,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 // constants
 
-#define RATE_CLOCK 10
+#define RATE_CLOCK 1
+// the longest clockTimer waits with nothing due, so that the cycle counter is
+// read long before it wraps
+#define RATE_CLOCK_MAX 1000
 #define RATE_CV 6
 
 
@@ -84,7 +88,13 @@ typedef struct {
 } aout_t;
 
 static aout_t aout[4];
-static bool metro_timer_enabled;
+// ticks counted from the cycle counter (see tele_get_ticks), the reading they
+// have been counted up to, and how many of them the scene has been ticked by
+static uint32_t ticks;
+static uint32_t tick_cycles;
+static uint32_t ticks_ticked;
+// set while a kEventTimer is waiting in the event queue
+static volatile bool clock_pending;
 static uint8_t front_timer;
 static uint8_t mod_key = 0, hold_key, hold_key_count = 0;
 
@@ -95,7 +105,6 @@ static softTimer_t keyTimer = {.next = NULL, .prev = NULL };
 static softTimer_t cvTimer = {.next = NULL, .prev = NULL };
 static softTimer_t adcTimer = {.next = NULL, .prev = NULL };
 static softTimer_t hidTimer = {.next = NULL, .prev = NULL };
-static softTimer_t metroTimer = {.next = NULL, .prev = NULL };
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,7 +117,6 @@ static void refreshTimer_callback(void* o);
 static void keyTimer_callback(void* o);
 static void adcTimer_callback(void* o);
 static void hidTimer_callback(void* o);
-static void metroTimer_callback(void* o);
 
 // event handler prototypes
 static void handler_None(int32_t data);
@@ -122,7 +130,6 @@ static void handler_MscConnect(int32_t data);
 static void handler_Trigger(int32_t data);
 static void handler_ScreenRefresh(int32_t data);
 static void handler_EventTimer(int32_t data);
-static void handler_AppCustom(int32_t data);
 
 // event queue
 static void empty_event_handlers(void);
@@ -134,6 +141,10 @@ static void check_events(void);
 static void process_keypress(uint8_t key, uint8_t mod_key, bool is_held_key);
 static bool process_global_keys(uint8_t key, uint8_t mod_key, bool is_held_key);
 
+// scene timing
+static void tick_scene(void);
+static void schedule_clock(void);
+
 // other
 static void render_init(void);
 
@@ -189,8 +200,11 @@ void cvTimer_callback(void* o) {
 }
 
 void clockTimer_callback(void* o) {
+    // handler_EventTimer catches up on however much time has passed, so one
+    // kEventTimer in the queue is enough
+    if (clock_pending) return;
     event_t e = {.type = kEventTimer, .data = 0 };
-    event_post(&e);
+    if (event_post(&e)) clock_pending = true;
 }
 
 void refreshTimer_callback(void* o) {
@@ -213,11 +227,6 @@ void hidTimer_callback(void* o) {
     event_post(&e);
 }
 
-void metroTimer_callback(void* o) {
-    event_t e = {.type = kEventAppCustom, .data = 0 };
-    event_post(&e);
-}
-
 
 ////////////////////////////////////////////////////////////////////////////////
 // event handlers
@@ -260,7 +269,11 @@ void handler_PollADC(int32_t data) {
 void handler_KeyTimer(int32_t data) {
     if (front_timer) {
         if (front_timer == 1) {
-            if (mode == M_PRESET_R) { process_preset_r_long_front(); }
+            if (mode == M_PRESET_R) {
+                tick_scene();
+                process_preset_r_long_front();
+                schedule_clock();
+            }
             front_timer = 0;
         }
         else
@@ -268,8 +281,11 @@ void handler_KeyTimer(int32_t data) {
     }
 
     if (hold_key) {
-        if (hold_key_count > 4)
+        if (hold_key_count > 4) {
+            tick_scene();
             process_keypress(hold_key, mod_key, true);
+            schedule_clock();
+        }
         else
             hold_key_count++;
     }
@@ -301,6 +317,7 @@ void handler_HidTimer(int32_t data) {
             if (frame_compare(frame[i]) == false) {
                 hold_key = frame[i];
                 hold_key_count = 0;
+                tick_scene();
                 process_keypress(hold_key, mod_key, false);
             }
         }
@@ -309,6 +326,7 @@ void handler_HidTimer(int32_t data) {
     }
 
     hid_clear_frame_dirty();
+    schedule_clock();
 }
 
 void handler_MscConnect(int32_t data) {
@@ -334,7 +352,11 @@ void handler_MscConnect(int32_t data) {
 }
 
 void handler_Trigger(int32_t data) {
-    if (!ss_get_mute(&scene_state, data)) { run_script(&scene_state, data); }
+    if (!ss_get_mute(&scene_state, data)) {
+        tick_scene();
+        run_script(&scene_state, data);
+        schedule_clock();
+    }
 }
 
 void handler_ScreenRefresh(int32_t data) {
@@ -355,18 +377,19 @@ void handler_ScreenRefresh(int32_t data) {
 }
 
 void handler_EventTimer(int32_t data) {
-    tele_tick(&scene_state, RATE_CLOCK);
-}
+    clock_pending = false;
 
-void handler_AppCustom(int32_t data) {
-    // If we need multiple custom event handlers then we can use an enum in the
-    // data argument. For now, we're just using it for the metro
-    if (ss_get_script_len(&scene_state, METRO_SCRIPT)) {
-        set_metro_icon(true);
-        run_script(&scene_state, METRO_SCRIPT);
-    }
-    else
-        set_metro_icon(false);
+    // the metro is run by tele_tick too
+    tick_scene();
+
+    // send the ii writes made by the scripts, and refresh the input cache
+    ii_poll(ticks_ticked);
+
+    // the metro script may have been edited
+    tele_metro_updated();
+    set_metro_load_icon(ss_get_metro_load(&scene_state));
+
+    schedule_clock();
 }
 
 
@@ -392,7 +415,11 @@ void assign_main_event_handlers() {
     app_event_handlers[kEventTrigger] = &handler_Trigger;
     app_event_handlers[kEventScreenRefresh] = &handler_ScreenRefresh;
     app_event_handlers[kEventTimer] = &handler_EventTimer;
-    app_event_handlers[kEventAppCustom] = &handler_AppCustom;
+
+    // don't catch up on the time spent without a kEventTimer handler (e.g. in
+    // USB disk mode), the kEventTimer posted then went to handler_None
+    ticks_ticked = tele_get_ticks();
+    clock_pending = false;
 }
 
 static void assign_msc_event_handlers(void) {
@@ -546,6 +573,41 @@ bool process_global_keys(uint8_t k, uint8_t m, bool is_held_key) {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// scene timing
+
+// the scene is ticked when something in it is due, or just before a script is
+// run (so that TIME is current, and what the script starts is timed from now)
+void tick_scene() {
+    const uint32_t now = tele_get_ticks();
+    if (now != ticks_ticked) {
+        tele_tick(&scene_state, now - ticks_ticked);
+        ticks_ticked = now;
+    }
+}
+
+// called once the scene has been ticked or a script has run, clockTimer then
+// waits until something is due, rather than waking every ms
+void schedule_clock() {
+    uint32_t ms = RATE_CLOCK_MAX;
+
+    const uint32_t deadline = tele_next_deadline(&scene_state);
+    if (deadline != TELE_NO_DEADLINE) {
+        // rounded up, if it still wakes a little early (its ms aren't in step
+        // with the ticks) the timer is just set again
+        const uint32_t due = (deadline + TICKS_PER_MS - 1) / TICKS_PER_MS;
+        if (due < ms) ms = due;
+    }
+
+    // ii_poll refreshes the input cache, and times out transfers
+    const uint16_t poll_ms = ii_get_poll_ms();
+    if (poll_ms && poll_ms < ms) ms = poll_ms;
+    if (ii_busy() || ms < RATE_CLOCK) ms = RATE_CLOCK;
+
+    timer_reset_set(&clockTimer, ms);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // other
 
@@ -564,36 +626,26 @@ void render_init(void) {
 ////////////////////////////////////////////////////////////////////////////////
 // teletype_io.h
 
-void tele_metro_updated() {
-    uint32_t metro_time = scene_state.variables.m;
-
-    bool m_act = scene_state.variables.m_act > 0;
-    if (metro_time < METRO_MIN_UNSUPPORTED_MS) {
-        metro_time = METRO_MIN_UNSUPPORTED_MS;
-    }
+// counted from the CPU's cycle counter, which wraps every 71 s at 60 MHz, so
+// this must be called more often than that (handler_EventTimer does)
+#define CYCLES_PER_TICK (FCPU_HZ / 1000 / TICKS_PER_MS)
 
-    if (m_act && !metro_timer_enabled) {  // enable the timer
-        timer_add(&metroTimer, metro_time, &metroTimer_callback, NULL);
-        metro_timer_enabled = true;
-    }
-    else if (!m_act && metro_timer_enabled) {  // disable the timer
-        timer_remove(&metroTimer);
-        metro_timer_enabled = false;
-    }
-    else if (metro_timer_enabled) {  // just update the time
-        timer_set(&metroTimer, metro_time);
-    }
+uint32_t tele_get_ticks() {
+    const uint32_t elapsed = Get_sys_count() - tick_cycles;
+    const uint32_t t = elapsed / CYCLES_PER_TICK;
+    tick_cycles += t * CYCLES_PER_TICK;
+    ticks += t;
+    return ticks;
+}
 
-    if (metro_timer_enabled && ss_get_script_len(&scene_state, METRO_SCRIPT))
+void tele_metro_updated() {
+    if (scene_state.metros[0].act &&
+        ss_get_script_len(&scene_state, METRO_SCRIPT))
         set_metro_icon(true);
     else
         set_metro_icon(false);
 }
 
-void tele_metro_reset() {
-    if (metro_timer_enabled) { timer_reset(&metroTimer); }
-}
-
 void tele_tr(uint8_t i, int16_t v) {
     if (v)
         gpio_set_pin_high(B08 + i);
@@ -631,17 +683,32 @@ void tele_cv_off(uint8_t i, int16_t v) {
     aout[i].off = v;
 }
 
-void tele_ii_tx(uint8_t addr, uint8_t* data, uint8_t l) {
-    i2c_master_tx(addr, data, l);
-}
-
-void tele_ii_rx(uint8_t addr, uint8_t* data, uint8_t l) {
-    i2c_master_rx(addr, data, l);
+// the twi driver blocks, so the transfer has finished by the time it returns,
+// but it's at least done from the main loop rather than from a script
+void tele_ii_start(ii_transfer_t* t) {
+    int status;
+    if (t->read)
+        status = i2c_master_rx(t->addr, t->data, t->l);
+    else
+        status = i2c_master_tx(t->addr, t->data, t->l);
+    ii_transfer_done(t, status == 0 ? II_OK : II_ERROR);
 }
 
 void tele_scene(uint8_t i) {
     preset_select = i;
     flash_read(i, &scene_state, &scene_text);
+    flash_load_pattern_banks(i);
+}
+
+// P.BANK can be run from a metro script, so a changed bank is kept in RAM
+// until the scene is saved, rather than being written to flash
+void tele_pattern_bank_read(uint8_t bank, scene_pattern_t* patterns) {
+    // scene_state still holds the bank being swapped out
+    flash_swap_pattern_bank(scene_state.pattern_bank, bank, patterns);
+}
+
+void tele_pattern_bank_write(uint8_t bank, const scene_pattern_t* patterns) {
+    // flash_swap_pattern_bank keeps it, if it differs from the saved scene
 }
 
 void tele_kill() {
@@ -688,6 +755,7 @@ int main(void) {
     preset_select = flash_last_saved_scene();
     ss_set_scene(&scene_state, preset_select);
     flash_read(preset_select, &scene_state, &scene_text);
+    flash_load_pattern_banks(preset_select);
 
     // screen init
     render_init();
@@ -705,8 +773,7 @@ int main(void) {
     timer_add(&adcTimer, 61, &adcTimer_callback, NULL);
     timer_add(&refreshTimer, 63, &refreshTimer_callback, NULL);
 
-    // manually call tele_metro_updated to sync metro to scene_state
-    metro_timer_enabled = false;
+    // manually call tele_metro_updated to sync the metro icon to scene_state
     tele_metro_updated();
 
     clear_delays(&scene_state);
@@ -720,6 +787,7 @@ int main(void) {
     set_mode(M_LIVE);
 
     run_script(&scene_state, INIT_SCRIPT);
+    schedule_clock();
 
     while (true) { check_events(); }
 }
@@ -107,6 +107,19 @@ void process_pattern_keys(uint8_t k, uint8_t m, bool is_held_key) {
             dirty = true;
         }
     }
+    // alt-[: select the previous pattern bank
+    else if (match_alt(m, k, HID_OPEN_BRACKET)) {
+        uint8_t bank = ss_get_pattern_bank(&scene_state);
+        if (bank > 0) ss_select_pattern_bank(&scene_state, bank - 1);
+        dirty = true;
+    }
+    // alt-]: select the next pattern bank
+    else if (match_alt(m, k, HID_CLOSE_BRACKET)) {
+        uint8_t bank = ss_get_pattern_bank(&scene_state);
+        if (bank < PATTERN_BANK_COUNT - 1)
+            ss_select_pattern_bank(&scene_state, bank + 1);
+        dirty = true;
+    }
     // <backspace>: delete a digit
     else if (match_no_mod(m, k, HID_BACKSPACE)) {
         int16_t v =
@@ -5,6 +5,9 @@
 #include "globals.h"
 #include "keyboard_helper.h"
 
+// teletype
+#include "ii_bus.h"
+
 // libavr32
 #include "font.h"
 #include "region.h"
@@ -96,8 +99,10 @@ bool screen_refresh_preset_r() {
 
 void do_preset_read() {
     flash_read(preset_select, &scene_state, &scene_text);
+    flash_load_pattern_banks(preset_select);
     flash_update_last_saved_scene(preset_select);
     ss_set_scene(&scene_state, preset_select);
+    ii_cache_clear();
 
     run_script(&scene_state, INIT_SCRIPT);
 
@@ -25,11 +25,17 @@
 #include "uhi_msc_mem.h"
 #include "usb_protocol_msc.h"
 
+// too big for the stack, a #P1 section (or #P2 and so on) of the scene being
+// read in is collected here, and written to flash once it has been read
+static scene_pattern_t empty_bank[PATTERN_COUNT];
+static scene_pattern_t import_bank[PATTERN_COUNT];
 
 void tele_usb_disk() {
     char input_buffer[32];
     print_dbg("\r\nusb");
 
+    ss_pattern_bank_init(empty_bank);
+
     uint8_t lun_state = 0;
 
     for (uint8_t lun = 0; (lun < uhi_msc_mem_get_lun()) && (lun < 8); lun++) {
@@ -131,59 +137,71 @@ void tele_usb_disk() {
                 }
             }
 
-            file_putc('\n');
-            file_putc('\n');
-            file_putc('#');
-            file_putc('P');
-            file_putc('\n');
-
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_len(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
+            // bank 0 is written as #P, as it always has been, the rest are
+            // #P1 and so on, and are left out if they are empty
+            for (uint8_t bank = 0; bank < PATTERN_BANK_COUNT; bank++) {
+                if (bank) {
+                    flash_read_pattern_bank(i, bank, ss_patterns_ptr(&scene));
+                    if (!memcmp(ss_patterns_ptr(&scene), empty_bank,
+                                ss_patterns_size()))
+                        continue;
+                }
 
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_wrap(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
+                file_putc('\n');
+                file_putc('\n');
+                file_putc('#');
+                file_putc('P');
+                if (bank) file_putc('0' + bank);
+                file_putc('\n');
 
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_start(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
+                for (int b = 0; b < 4; b++) {
+                    itoa(ss_get_pattern_len(&scene, b), input, 10);
+                    file_write_buf((uint8_t*)input, strlen(input));
+                    if (b == 3)
+                        file_putc('\n');
+                    else
+                        file_putc('\t');
+                }
 
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_end(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
+                for (int b = 0; b < 4; b++) {
+                    itoa(ss_get_pattern_wrap(&scene, b), input, 10);
+                    file_write_buf((uint8_t*)input, strlen(input));
+                    if (b == 3)
+                        file_putc('\n');
+                    else
+                        file_putc('\t');
+                }
 
-            file_putc('\n');
+                for (int b = 0; b < 4; b++) {
+                    itoa(ss_get_pattern_start(&scene, b), input, 10);
+                    file_write_buf((uint8_t*)input, strlen(input));
+                    if (b == 3)
+                        file_putc('\n');
+                    else
+                        file_putc('\t');
+                }
 
-            for (int l = 0; l < 64; l++) {
                 for (int b = 0; b < 4; b++) {
-                    itoa(ss_get_pattern_val(&scene, b, l), input, 10);
+                    itoa(ss_get_pattern_end(&scene, b), input, 10);
                     file_write_buf((uint8_t*)input, strlen(input));
                     if (b == 3)
                         file_putc('\n');
                     else
                         file_putc('\t');
                 }
+
+                file_putc('\n');
+
+                for (int l = 0; l < 64; l++) {
+                    for (int b = 0; b < 4; b++) {
+                        itoa(ss_get_pattern_val(&scene, b, l), input, 10);
+                        file_write_buf((uint8_t*)input, strlen(input));
+                        if (b == 3)
+                            file_putc('\n');
+                        else
+                            file_putc('\t');
+                    }
+                }
             }
 
             file_close();
@@ -234,6 +252,9 @@ void tele_usb_disk() {
                     uint8_t b = 0;
                     uint16_t num = 0;
                     int8_t neg = 1;
+                    scene_pattern_t *patterns = ss_patterns_ptr(&scene);
+                    uint8_t import_bank_no = 0;
+                    uint8_t banks_read = 0;
 
                     char input[32];
                     memset(input, 0, sizeof(input));
@@ -243,6 +264,12 @@ void tele_usb_disk() {
                         // print_dbg_char(c);
 
                         if (c == '#') {
+                            if (patterns == import_bank) {
+                                flash_write_pattern_bank(i, import_bank_no,
+                                                         import_bank);
+                                patterns = ss_patterns_ptr(&scene);
+                            }
+
                             if (!file_eof()) {
                                 c = toupper(file_getc());
                                 // print_dbg_char(c);
@@ -262,6 +289,20 @@ void tele_usb_disk() {
                                 p = 0;
 
                                 if (!file_eof()) c = toupper(file_getc());
+
+                                // #P is bank 0, #P1 and up the other banks
+                                if (s == 10) {
+                                    patterns = ss_patterns_ptr(&scene);
+                                    if (c > '0' &&
+                                        c < '0' + PATTERN_BANK_COUNT) {
+                                        import_bank_no = c - '0';
+                                        banks_read |= 1 << import_bank_no;
+                                        ss_pattern_bank_init(import_bank);
+                                        patterns = import_bank;
+                                        if (!file_eof())
+                                            c = toupper(file_getc());
+                                    }
+                                }
                             }
                             else
                                 s = -1;
@@ -331,8 +372,8 @@ void tele_usb_disk() {
                             if (c == '\n' || c == '\t') {
                                 if (b < 4) {
                                     if (l > 3) {
-                                        ss_set_pattern_val(&scene, b, l - 4,
-                                                           neg * num);
+                                        if (l - 4 < PATTERN_LENGTH)
+                                            patterns[b].val[l - 4] = neg * num;
                                         // print_dbg("\r\nset: ");
                                         // print_dbg_ulong(b);
                                         // print_dbg(" ");
@@ -341,16 +382,16 @@ void tele_usb_disk() {
                                         // print_dbg_ulong(num);
                                     }
                                     else if (l == 0) {
-                                        ss_set_pattern_len(&scene, b, num);
+                                        patterns[b].len = num;
                                     }
                                     else if (l == 1) {
-                                        ss_set_pattern_wrap(&scene, b, num);
+                                        patterns[b].wrap = num;
                                     }
                                     else if (l == 2) {
-                                        ss_set_pattern_start(&scene, b, num);
+                                        patterns[b].start = num;
                                     }
                                     else if (l == 3) {
-                                        ss_set_pattern_end(&scene, b, num);
+                                        patterns[b].end = num;
                                     }
                                 }
 
@@ -360,7 +401,9 @@ void tele_usb_disk() {
 
                                 if (c == '\n') {
                                     if (p) l++;
-                                    if (l > 68) s = -1;
+                                    // skip anything after the values, up
+                                    // to the next section
+                                    if (l > 68) s = 11;
                                     b = 0;
                                     p = 0;
                                 }
@@ -381,7 +424,15 @@ void tele_usb_disk() {
 
                     file_close();
 
+                    if (patterns == import_bank)
+                        flash_write_pattern_bank(i, import_bank_no,
+                                                 import_bank);
                     flash_write(i, &scene, &text);
+                    // the banks the file doesn't have are empty
+                    for (uint8_t bank = 1; bank < PATTERN_BANK_COUNT; bank++) {
+                        if (!(banks_read & (1 << bank)))
+                            flash_write_pattern_bank(i, bank, empty_bank);
+                    }
                 }
             }
 
@@ -0,0 +1,349 @@
+#include "ii_sim.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "ii.h"
+#include "ops/telex.h"
+#include "state.h"
+
+#define FOLLOWER_COUNT 32
+#define WRITE_HISTORY 64
+#define TXI_INPUTS 8
+#define SOURCE_COUNT (SCRIPT_COUNT - II_SOURCE_NONE)
+#define FLAGGED_LENGTH 16
+
+typedef enum {
+    MODEL_REGISTERS,  // answers a get from the last matching write
+    MODEL_TXI         // answers a read of the input it was last sent
+} model_t;
+
+typedef struct {
+    uint8_t l;
+    uint8_t data[II_TX_MAX_LENGTH];
+} write_t;
+
+typedef struct {
+    const char *name;
+    uint8_t addr;
+    model_t model;
+    bool connected;
+    write_t writes[WRITE_HISTORY];  // a ring, the newest is before next
+    uint8_t next;
+    uint8_t reply[II_TX_MAX_LENGTH];  // what a read returns
+    int16_t inputs[TXI_INPUTS];
+} follower_t;
+
+typedef struct {
+    uint64_t tick;
+    ii_sim_stats_t stats;
+} flagged_tick_t;
+
+static struct {
+    ii_sim_config_t config;
+    follower_t followers[FOLLOWER_COUNT];
+    uint8_t follower_count;
+    uint64_t free_at;  // when the bus is next free
+    ii_sim_stats_t sources[SOURCE_COUNT];
+
+    bool started;
+    uint64_t first_tick;
+    uint64_t tick;            // the tick being counted
+    ii_sim_stats_t current;   // so far in it
+    ii_sim_stats_t total;     // in every tick before it
+    ii_sim_stats_t peak;      // the most in any one tick
+    uint32_t over_budget;
+    flagged_tick_t flagged[FLAGGED_LENGTH];  // the first ticks over budget
+} sim;
+
+
+/////////////////////////////////////////////////////////////////
+// FOLLOWERS ////////////////////////////////////////////////////
+
+static void add_follower(const char *name, uint8_t addr, model_t model) {
+    if (sim.follower_count == FOLLOWER_COUNT) return;
+    for (uint8_t i = 0; i < sim.follower_count; i++)
+        if (sim.followers[i].addr == addr) return;
+
+    follower_t *f = &sim.followers[sim.follower_count++];
+    memset(f, 0, sizeof(*f));
+    f->name = name;
+    f->addr = addr;
+    f->model = model;
+    f->connected = true;
+}
+
+static follower_t *find_follower(uint8_t addr) {
+    for (uint8_t i = 0; i < sim.follower_count; i++)
+        if (sim.followers[i].addr == addr) return &sim.followers[i];
+    return NULL;
+}
+
+// a get is cmd | II_GET followed by the first bytes of the matching write,
+// the reply is the rest of it
+static bool answer_get(follower_t *f, const uint8_t *data, uint8_t l) {
+    for (uint8_t i = 1; i <= WRITE_HISTORY; i++) {
+        const write_t *w =
+            &f->writes[(f->next + WRITE_HISTORY - i) % WRITE_HISTORY];
+        if (w->l <= l || w->data[0] == data[0] ||
+            (w->data[0] | II_GET) != data[0] ||
+            memcmp(&w->data[1], &data[1], l - 1))
+            continue;
+
+        memset(f->reply, 0, sizeof(f->reply));
+        memcpy(f->reply, &w->data[l], w->l - l);
+        return true;
+    }
+
+    // a get of a value that's never been set
+    if ((data[0] & II_GET) == II_GET) {
+        memset(f->reply, 0, sizeof(f->reply));
+        return true;
+    }
+    return false;
+}
+
+static void write_registers(follower_t *f, const uint8_t *data, uint8_t l) {
+    if (answer_get(f, data, l)) return;
+
+    write_t *w = &f->writes[f->next];
+    f->next = (f->next + 1) % WRITE_HISTORY;
+    w->l = l;
+    memcpy(w->data, data, l);
+}
+
+// a TXi is sent the input to read (0-7), plus 8 for the quantized value or
+// 16 for the note number, everything else it's sent sets up its inputs
+static void write_txi(follower_t *f, const uint8_t *data, uint8_t l) {
+    if (l != 1) return;
+
+    const int32_t value = f->inputs[data[0] & 7];
+    // 16384 is 10V, so a semitone is 16384 / 120
+    const int32_t note = (value * 120 + (value < 0 ? -8192 : 8192)) / 16384;
+    int32_t reply = value;
+    if ((data[0] >> 3) == 1)
+        reply = (note * 16384 + (note < 0 ? -60 : 60)) / 120;
+    else if ((data[0] >> 3) == 2)
+        reply = note;
+
+    f->reply[0] = (uint16_t)reply >> 8;
+    f->reply[1] = reply & 0xff;
+}
+
+void ii_sim_connect(uint8_t addr, bool connected) {
+    follower_t *f = find_follower(addr);
+    if (f) f->connected = connected;
+}
+
+void ii_sim_set_input(uint8_t addr, uint8_t input, int16_t value) {
+    follower_t *f = find_follower(addr);
+    if (f && f->model == MODEL_TXI && input < TXI_INPUTS)
+        f->inputs[input] = value;
+}
+
+
+/////////////////////////////////////////////////////////////////
+// STATISTICS ///////////////////////////////////////////////////
+
+static uint64_t tick_us() {
+    return (uint64_t)sim.config.tick_ms * 1000;
+}
+
+static bool over_budget(const ii_sim_stats_t *s) {
+    return s->busy * 100 > tick_us() * sim.config.budget;
+}
+
+static void add_stats(ii_sim_stats_t *to, const ii_sim_stats_t *s) {
+    to->transfers += s->transfers;
+    to->bytes += s->bytes;
+    to->errors += s->errors;
+    to->busy += s->busy;
+}
+
+static void end_tick() {
+    const ii_sim_stats_t *s = &sim.current;
+    if (over_budget(s)) {
+        if (sim.over_budget < FLAGGED_LENGTH) {
+            sim.flagged[sim.over_budget].tick = sim.tick;
+            sim.flagged[sim.over_budget].stats = *s;
+        }
+        sim.over_budget++;
+    }
+
+    add_stats(&sim.total, s);
+    if (s->transfers > sim.peak.transfers) sim.peak.transfers = s->transfers;
+    if (s->bytes > sim.peak.bytes) sim.peak.bytes = s->bytes;
+    if (s->errors > sim.peak.errors) sim.peak.errors = s->errors;
+    if (s->busy > sim.peak.busy) sim.peak.busy = s->busy;
+    memset(&sim.current, 0, sizeof(sim.current));
+}
+
+// the ticks in between had no transfers, so there's nothing to count
+static void move_to_tick(uint64_t tick) {
+    if (!sim.started) {
+        sim.started = true;
+        sim.first_tick = sim.tick = tick;
+    }
+    if (tick <= sim.tick) return;
+    end_tick();
+    sim.tick = tick;
+}
+
+static void count_transfer(int8_t source, uint64_t start, uint32_t us,
+                           uint8_t bytes, bool error) {
+    ii_sim_stats_t s = {
+        .transfers = 1, .bytes = bytes, .errors = error, .busy = us
+    };
+    if (source >= II_SOURCE_NONE && source < SCRIPT_COUNT)
+        add_stats(&sim.sources[source - II_SOURCE_NONE], &s);
+
+    move_to_tick(start / tick_us());
+    sim.current.transfers++;
+    sim.current.bytes += bytes;
+    sim.current.errors += error;
+
+    // the busy time is split between the ticks it falls in
+    while (us) {
+        move_to_tick(start / tick_us());
+        const uint64_t left = (sim.tick + 1) * tick_us() - start;
+        const uint32_t part = us < left ? us : left;
+        sim.current.busy += part;
+        start += part;
+        us -= part;
+    }
+}
+
+ii_sim_stats_t ii_sim_source_stats(int8_t source) {
+    ii_sim_stats_t s = { 0 };
+    if (source >= II_SOURCE_NONE && source < SCRIPT_COUNT)
+        s = sim.sources[source - II_SOURCE_NONE];
+    return s;
+}
+
+uint32_t ii_sim_ticks_over_budget() {
+    return sim.over_budget + over_budget(&sim.current);
+}
+
+static const char *source_name(int8_t source) {
+    static const char *names[SOURCE_COUNT] = {
+        "cache", "live", "1", "2", "3", "4", "5", "6", "7", "8", "M", "I"
+    };
+    return names[source - II_SOURCE_NONE];
+}
+
+static void print_stats(FILE *f, const char *name, const ii_sim_stats_t *s,
+                        double ticks) {
+    fprintf(f, "  %-6s %10.1f %10.1f %10.1f %9.2f\n", name,
+            s->transfers / ticks, s->bytes / ticks, s->errors / ticks,
+            s->busy / ticks / 1000);
+}
+
+void ii_sim_report(FILE *f, uint64_t now) {
+    ii_sim_stats_t total = sim.total;
+    add_stats(&total, &sim.current);
+    ii_sim_stats_t peak = sim.peak;
+    if (sim.current.transfers > peak.transfers)
+        peak.transfers = sim.current.transfers;
+    if (sim.current.bytes > peak.bytes) peak.bytes = sim.current.bytes;
+    if (sim.current.errors > peak.errors) peak.errors = sim.current.errors;
+    if (sim.current.busy > peak.busy) peak.busy = sim.current.busy;
+
+    const uint64_t last = now / tick_us();
+    const uint64_t ticks =
+        sim.started && last > sim.first_tick ? last - sim.first_tick + 1 : 1;
+
+    fprintf(f, "ii bus: %" PRIu32 " Hz, %" PRIu16 " ms ticks, %" PRIu8
+               "%% budget, %" PRIu64 " ticks\n",
+            sim.config.clock_hz, sim.config.tick_ms, sim.config.budget, ticks);
+    fprintf(f, "  %-6s %10s %10s %10s %9s\n", "tick", "transfers", "bytes",
+            "errors", "busy ms");
+    print_stats(f, "mean", &total, ticks);
+    print_stats(f, "peak", &peak, 1);
+
+    fprintf(f, "per script, per tick:\n");
+    for (int8_t i = II_SOURCE_NONE; i < SCRIPT_COUNT; i++) {
+        const ii_sim_stats_t *s = &sim.sources[i - II_SOURCE_NONE];
+        if (s->transfers) print_stats(f, source_name(i), s, ticks);
+    }
+
+    const uint32_t flagged = ii_sim_ticks_over_budget();
+    fprintf(f, "over budget: %" PRIu32 " ticks\n", flagged);
+    for (uint32_t i = 0; i < flagged && i < FLAGGED_LENGTH; i++) {
+        const flagged_tick_t *t = &sim.flagged[i];
+        const bool current = i == sim.over_budget;
+        const uint64_t tick = current ? sim.tick : t->tick;
+        const ii_sim_stats_t *s = current ? &sim.current : &t->stats;
+        fprintf(f, "  at %" PRIu64 " ms: %" PRIu32 " transfers, %" PRIu32
+                   " bytes, %.2f ms busy\n",
+                tick * sim.config.tick_ms, s->transfers, s->bytes,
+                s->busy / 1000.0);
+    }
+}
+
+
+/////////////////////////////////////////////////////////////////
+// BUS //////////////////////////////////////////////////////////
+
+void ii_sim_default_config(ii_sim_config_t *config) {
+    config->clock_hz = 100000;
+    config->byte_us = 0;
+    config->transfer_us = 20;
+    config->tick_ms = 10;
+    config->budget = 80;
+}
+
+void ii_sim_init(const ii_sim_config_t *config) {
+    memset(&sim, 0, sizeof(sim));
+    sim.config = *config;
+    if (sim.config.clock_hz == 0) sim.config.clock_hz = 100000;
+    if (sim.config.tick_ms == 0) sim.config.tick_ms = 1;
+
+    for (uint8_t i = 0; i < 8; i++) {
+        add_follower("TXo", TO + i, MODEL_REGISTERS);
+        add_follower("TXi", TI + i, MODEL_TXI);
+    }
+    add_follower("JF", JF_ADDR, MODEL_REGISTERS);
+    for (uint8_t i = 0; i < 4; i++)
+        add_follower("Ansible", II_ANSIBLE_ADDR + i * 2, MODEL_REGISTERS);
+    add_follower("KR", II_KR_ADDR, MODEL_REGISTERS);
+    add_follower("ME", II_MP_ADDR, MODEL_REGISTERS);
+    add_follower("LV", II_LV_ADDR, MODEL_REGISTERS);
+    add_follower("CY", II_CY_ADDR, MODEL_REGISTERS);
+    // the Trilogy modules use the top 4 bits of each command as the address
+    add_follower("WW", WW_PRESET & 0xF0, MODEL_REGISTERS);
+    add_follower("MP", MP_PRESET & 0xF0, MODEL_REGISTERS);
+    add_follower("ES", ES_PRESET & 0xF0, MODEL_REGISTERS);
+}
+
+// a start bit, 9 bits for the address and each byte (with the ack) and a
+// stop bit, rounded up to the next us
+uint32_t ii_sim_transfer_time(uint8_t l) {
+    const uint32_t bits = 9 * (1 + l) + 2;
+    return (bits * 1000000 + sim.config.clock_hz - 1) / sim.config.clock_hz +
+           l * sim.config.byte_us + sim.config.transfer_us;
+}
+
+ii_status_t ii_sim_run(ii_transfer_t *t, uint64_t now, uint64_t *done) {
+    const uint64_t start = now > sim.free_at ? now : sim.free_at;
+    follower_t *f = find_follower(t->addr);
+
+    // nothing acknowledges the address, so the transfer ends there
+    if (!f || !f->connected) {
+        const uint32_t us = ii_sim_transfer_time(0);
+        count_transfer(t->source, start, us, 1, true);
+        *done = sim.free_at = start + us;
+        return II_ERROR;
+    }
+
+    if (t->read)
+        memcpy(t->data, f->reply, t->l);
+    else if (t->l && f->model == MODEL_TXI)
+        write_txi(f, t->data, t->l);
+    else if (t->l)
+        write_registers(f, t->data, t->l);
+
+    const uint32_t us = ii_sim_transfer_time(t->l);
+    count_transfer(t->source, start, us, 1 + t->l, false);
+    *done = sim.free_at = start + us;
+    return II_OK;
+}
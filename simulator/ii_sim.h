@@ -0,0 +1,65 @@
+#ifndef _II_SIM_H_
+#define _II_SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "ii_bus.h"
+
+// A model of the ii bus and the followers on it, for host builds, so that the
+// bus time a scene uses can be measured (and bus saturation reproduced)
+// without the hardware. The followers are simple stand-ins: TXo, Just
+// Friends, Ansible (KR, ME, LV, CY and its TR and CV), and the Trilogy modules
+// keep the writes sent to them and answer a get from the last matching write,
+// TXi answers reads of its inputs with the values given to ii_sim_set_input.
+//
+// All times are in us.
+
+typedef struct {
+    uint32_t clock_hz;     // the SCL rate, 100 kHz or 400 kHz
+    uint16_t byte_us;      // added to each byte, for followers that stretch it
+    uint16_t transfer_us;  // added to each transfer, the gap between them
+    uint16_t tick_ms;      // the length of a tick, for the statistics
+    uint8_t budget;        // the % of a tick the bus can be busy for
+} ii_sim_config_t;
+
+void ii_sim_default_config(ii_sim_config_t *config);
+
+// connects every follower, and clears their state and the statistics
+void ii_sim_init(const ii_sim_config_t *config);
+
+// a follower that isn't connected doesn't acknowledge its address
+void ii_sim_connect(uint8_t addr, bool connected);
+
+// sets the voltage on one of the 8 inputs of the TXi at addr (IN 1-4 are
+// inputs 4-7), in the same units as TI.IN, the quantized reads and note
+// numbers are worked out from it (the scales set on the TXi are ignored)
+void ii_sim_set_input(uint8_t addr, uint8_t input, int16_t value);
+
+// the time a transfer of l bytes holds the bus for
+uint32_t ii_sim_transfer_time(uint8_t l);
+
+// runs t on the bus as soon as it's free after now, a read fills t->data
+// from the follower, done is set to when it finishes, returns its status
+// (which the caller passes to ii_transfer_done once it's finished)
+ii_status_t ii_sim_run(ii_transfer_t *t, uint64_t now, uint64_t *done);
+
+typedef struct {
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t errors;
+    uint64_t busy;
+} ii_sim_stats_t;
+
+// the totals for a source (see ii_transfer_t.source)
+ii_sim_stats_t ii_sim_source_stats(int8_t source);
+
+// the ticks so far where the bus was busy for more than the budget
+uint32_t ii_sim_ticks_over_budget(void);
+
+// prints the bus use per tick and per script up to now, and the ticks that
+// went over the budget
+void ii_sim_report(FILE *f, uint64_t now);
+
+#endif
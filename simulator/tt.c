@@ -1,26 +1,40 @@
+// needed for clock_gettime and select with -std=c99
+#define _POSIX_C_SOURCE 200112L
+
 #include <ctype.h>
 #include <errno.h>
 #include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/select.h>
 #include <time.h>
+#include <unistd.h>
 
+#include "ii_sim.h"
 #include "teletype.h"
 #include "teletype_io.h"
 #include "util.h"
 
+#define US_PER_TICK (1000 / TICKS_PER_MS)
+
+// a scene given a run time is run in virtual time rather than in real time,
+// time passes while waiting for the transfer on the bus to finish, otherwise
+// only when the scene has nothing else to do (see run_scene)
+static bool virtual_time = false;
+static uint64_t virtual_us = 0;
+static ii_transfer_t *in_flight = NULL;
+static ii_status_t in_flight_status;
+static uint64_t in_flight_done;
+
+static uint64_t now_us(void);
+
 
 void tele_metro_updated() {
     printf("METRO UPDATED");
     printf("\n");
 }
 
-void tele_metro_reset() {
-    printf("METRO RESET");
-    printf("\n");
-}
-
 void tele_tr(uint8_t i, int16_t v) {
     printf("TR  i:%" PRIu8 " v:%" PRId16, i, v);
     printf("\n");
@@ -51,17 +65,31 @@ void tele_cv_off(uint8_t i, int16_t v) {
     printf("\n");
 }
 
-void tele_ii_tx(uint8_t addr, uint8_t *data, uint8_t l) {
-    printf("II_tx  addr:%" PRIu8 " l:%" PRIu8, addr, l);
-    printf("\n");
-    for (size_t i = 0; i < l; i++) {
-        printf("[%" PRIuPTR "] = %" PRIu8 "\n", i, data[i]);
+void tele_ii_start(ii_transfer_t *t) {
+    if (t->read) {
+        printf("II_rx  addr:%" PRIu8 " l:%" PRIu8, t->addr, t->l);
+        printf("\n");
+    }
+    else {
+        printf("II_tx  addr:%" PRIu8 " l:%" PRIu8, t->addr, t->l);
+        printf("\n");
+        for (size_t i = 0; i < t->l; i++) {
+            printf("[%" PRIuPTR "] = %" PRIu8 "\n", i, t->data[i]);
+        }
     }
-}
 
-void tele_ii_rx(uint8_t addr, uint8_t *data, uint8_t l) {
-    printf("II_rx  addr:%" PRIu8 " l:%" PRIu8, addr, l);
-    printf("\n");
+    // in real time the transfer has finished by the time anything could
+    // notice, the simulated bus still keeps track of how long it took
+    uint64_t done;
+    const ii_status_t status = ii_sim_run(t, now_us(), &done);
+    if (!virtual_time) {
+        ii_transfer_done(t, status);
+        return;
+    }
+
+    in_flight = t;
+    in_flight_status = status;
+    in_flight_done = done;
 }
 
 void tele_scene(uint8_t i) {
@@ -74,6 +102,32 @@ void tele_pattern_updated() {
     printf("\n");
 }
 
+// the simulator only has the one scene, so its pattern banks are simply kept
+// in memory
+static scene_pattern_t pattern_banks[PATTERN_BANK_COUNT][PATTERN_COUNT];
+static bool pattern_banks_ready = false;
+
+static void pattern_banks_init() {
+    if (pattern_banks_ready) return;
+    for (uint8_t i = 0; i < PATTERN_BANK_COUNT; i++)
+        ss_pattern_bank_init(pattern_banks[i]);
+    pattern_banks_ready = true;
+}
+
+void tele_pattern_bank_read(uint8_t bank, scene_pattern_t *patterns) {
+    printf("PATTERN BANK READ  bank:%" PRIu8, bank);
+    printf("\n");
+    pattern_banks_init();
+    memcpy(patterns, pattern_banks[bank], sizeof(pattern_banks[bank]));
+}
+
+void tele_pattern_bank_write(uint8_t bank, const scene_pattern_t *patterns) {
+    printf("PATTERN BANK WRITE  bank:%" PRIu8, bank);
+    printf("\n");
+    pattern_banks_init();
+    memcpy(pattern_banks[bank], patterns, sizeof(pattern_banks[bank]));
+}
+
 void tele_kill() {
     printf("KILL");
     printf("\n");
@@ -90,7 +144,143 @@ bool tele_get_input_state(uint8_t n) {
     return false;
 }
 
-int main() {
+// in ticks, see TICKS_PER_MS
+static uint64_t now_ticks() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 * TICKS_PER_MS +
+           ts.tv_nsec / (1000000 / TICKS_PER_MS);
+}
+
+static void advance_virtual_time(uint64_t us) {
+    virtual_us = us;
+    if (in_flight && virtual_us >= in_flight_done) {
+        ii_transfer_t *t = in_flight;
+        in_flight = NULL;
+        ii_transfer_done(t, in_flight_status);
+    }
+}
+
+static uint64_t now_us() {
+    return virtual_time ? virtual_us : now_ticks() * US_PER_TICK;
+}
+
+uint32_t tele_get_ticks() {
+    if (!virtual_time) return now_ticks();
+
+    // only called repeatedly while waiting for the bus, so each call is a
+    // tick spent waiting
+    if (in_flight) {
+        const uint64_t next = virtual_us + US_PER_TICK;
+        advance_virtual_time(next < in_flight_done ? next : in_flight_done);
+    }
+    return virtual_us / US_PER_TICK;
+}
+
+// sleep until there is some input, waking up to run delays and end TR pulses
+// when they're due (rather than ticking at a fixed rate)
+static void wait_for_input(scene_state_t *ss, uint64_t *last_tick) {
+    while (true) {
+        const uint32_t deadline = tele_next_deadline(ss);
+        struct timeval tv;
+        struct timeval *timeout = NULL;
+        if (deadline != TELE_NO_DEADLINE) {
+            const uint32_t us = 1000 / TICKS_PER_MS;
+            tv.tv_sec = deadline / (1000 * TICKS_PER_MS);
+            tv.tv_usec = (deadline % (1000 * TICKS_PER_MS)) * us;
+            timeout = &tv;
+        }
+
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(STDIN_FILENO, &fds);
+        const int ready = select(STDIN_FILENO + 1, &fds, NULL, NULL, timeout);
+
+        const uint64_t now = now_ticks();
+        tele_tick(ss, now - *last_tick);
+        *last_tick = now;
+        ii_poll(tele_get_ticks());
+
+        if (ready != 0) return;
+    }
+}
+
+// reads a scene in the same format as the USB disk backups, only the scripts
+// are loaded
+static bool load_scene(scene_state_t *ss, const char *filename) {
+    FILE *f = fopen(filename, "r");
+    if (!f) return false;
+
+    char line[64];
+    int script = -1;
+    uint8_t l = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        for (char *c = line; *c; c++) *c = toupper(*c);
+
+        if (line[0] == '#') {
+            l = 0;
+            if (line[1] >= '1' && line[1] <= '8')
+                script = line[1] - '1';
+            else if (line[1] == 'M')
+                script = METRO_SCRIPT;
+            else if (line[1] == 'I')
+                script = INIT_SCRIPT;
+            else
+                script = -1;
+            continue;
+        }
+        if (script == -1 || !line[0] || l == SCRIPT_MAX_COMMANDS) continue;
+
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        if (parse(line, &cmd, error_msg) != E_OK ||
+            validate(&cmd, error_msg) != E_OK) {
+            fprintf(stderr, "%s: invalid command: %s\n", filename, line);
+            continue;
+        }
+        ss_overwrite_script_command(ss, script, l++, &cmd);
+    }
+
+    fclose(f);
+    return true;
+}
+
+// runs the scene for ms of virtual time, from its init script, stepping
+// from one deadline to the next (or to the end of the transfer on the bus),
+// but at most a ms at a time so that the input cache is refreshed, the time
+// spent waiting for the bus while a script runs is ticked afterwards
+static void run_scene(scene_state_t *ss, uint32_t ms) {
+    const uint64_t end = (uint64_t)ms * 1000;
+    uint64_t ticked = 0;
+    run_script(ss, INIT_SCRIPT);
+
+    while (virtual_us < end) {
+        ii_poll(tele_get_ticks());
+
+        uint32_t step = tele_next_deadline(ss);
+        if (step > TICKS_PER_MS) step = TICKS_PER_MS;
+        uint64_t next = (ticked + step) * US_PER_TICK;
+        if (in_flight && in_flight_done < next) next = in_flight_done;
+        if (next > end) next = end;
+        if (next > virtual_us) advance_virtual_time(next);
+
+        const uint64_t now = virtual_us / US_PER_TICK;
+        tele_tick(ss, now - ticked);
+        ticked = now;
+    }
+    ii_wait();
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: tt [-c clock_hz] [-t tick_ms] [-b budget] [scene [ms]]\n"
+            "  runs the scene for ms of virtual time and prints the ii bus\n"
+            "  use, or without ms, loads it and starts the live mode\n");
+    exit(1);
+}
+
+int main(int argc, char **argv) {
     char *in;
     time_t t;
     error_t status;
@@ -98,6 +288,22 @@ int main() {
 
     srand((unsigned)time(&t));
 
+    ii_sim_config_t config;
+    ii_sim_default_config(&config);
+    int opt;
+    while ((opt = getopt(argc, argv, "c:t:b:")) != -1) {
+        if (opt == 'c')
+            config.clock_hz = strtoul(optarg, NULL, 10);
+        else if (opt == 't')
+            config.tick_ms = strtoul(optarg, NULL, 10);
+        else if (opt == 'b')
+            config.budget = strtoul(optarg, NULL, 10);
+        else
+            usage();
+    }
+    if (argc - optind > 2) usage();
+    ii_sim_init(&config);
+
     // tele_command_t stored;
     // stored.data[0].t = OP;
     // stored.data[0].v = 2;
@@ -116,9 +322,24 @@ int main() {
 
     scene_state_t ss;
     ss_init(&ss);
+    if (optind < argc && !load_scene(&ss, argv[optind])) {
+        fprintf(stderr, "can't open %s\n", argv[optind]);
+        return 1;
+    }
+    if (argc - optind == 2) {
+        virtual_time = true;
+        run_scene(&ss, strtoul(argv[optind + 1], NULL, 10));
+        ii_sim_report(stderr, now_us());
+        free(in);
+        return 0;
+    }
+    if (optind < argc) run_script(&ss, INIT_SCRIPT);
+    uint64_t last_tick = now_ticks();
 
     do {
         printf("> ");
+        fflush(stdout);
+        wait_for_input(&ss, &last_tick);
         fgets(in, 256, stdin);
 
         i = 0;
@@ -140,6 +361,7 @@ int main() {
             if (status == E_OK) {
                 process_result_t output = process_command(&ss, &es, &temp);
                 if (output.has_value) { printf(">>> %i\n", output.value); }
+                ii_poll(tele_get_ticks());
             }
         }
         else {
@@ -148,11 +370,11 @@ int main() {
             printf("\n");
         }
 
-        // tele_tick(100);
         printf("\n");
     } while (in[0] != 10);
 
     free(in);
 
+    ii_sim_report(stderr, now_us());
     printf("(teletype exit.)\n");
 }
@@ -0,0 +1,467 @@
+#include "bytecode.h"
+
+#include <string.h>  // memcpy
+
+#include "ops/controlflow.h"
+#include "ops/maths.h"
+#include "ops/op.h"
+#include "ops/patterns.h"
+#include "ops/variables.h"
+
+static void emit(tele_bytecode_t *out, tele_instr_tag_t tag, int16_t value) {
+    out->data[out->length].tag = tag;
+    out->data[out->length].value = value;
+    out->length++;
+}
+
+// variables made with MAKE_SIMPLE_VARIABLE_OP can be accessed directly by the
+// executor as long as their offset fits in an instruction
+static bool is_simple_variable(const tele_op_t *op) {
+    return op->get == op_peek_i16 && op->set == op_poke_i16 &&
+           (size_t)op->data <= INT16_MAX;
+}
+
+static void emit_get(tele_bytecode_t *out, int16_t op_idx) {
+    const tele_op_t *op = tele_ops[op_idx];
+
+    // compare the functions rather than the op index so that aliases (e.g. +
+    // for ADD) are covered too
+    if (is_simple_variable(op))
+        emit(out, I_PEEK, (size_t)op->data);
+    else if (op->get == op_ADD.get)
+        emit(out, I_ADD, 0);
+    else if (op->get == op_SUB.get)
+        emit(out, I_SUB, 0);
+    else if (op->get == op_EQ.get)
+        emit(out, I_EQ, 0);
+    else if (op->get == op_NE.get)
+        emit(out, I_NE, 0);
+    else if (op->get == op_LT.get)
+        emit(out, I_LT, 0);
+    else if (op->get == op_GT.get)
+        emit(out, I_GT, 0);
+    else if (op->get == op_SCRIPT.get)
+        emit(out, I_SCRIPT, 0);
+    else
+        emit(out, I_GET, op_idx);
+}
+
+static void emit_set(tele_bytecode_t *out, int16_t op_idx) {
+    const tele_op_t *op = tele_ops[op_idx];
+
+    if (is_simple_variable(op))
+        emit(out, I_POKE, (size_t)op->data);
+    else
+        emit(out, I_SET, op_idx);
+}
+
+// if the params of a pure op are all literals (i.e. the last instructions
+// emitted for this sub), then run the op now and replace them with the result
+static bool fold_pure_op(tele_bytecode_t *out, uint8_t sub_start,
+                         const tele_op_t *op) {
+    if (!op->pure || !op->returns || out->length - sub_start < op->params)
+        return false;
+
+    const uint8_t first = out->length - op->params;
+    for (uint8_t i = first; i < out->length; i++)
+        if (out->data[i].tag != I_NUMBER) return false;
+
+    command_state_t cs;
+    cs_init(&cs);
+    for (uint8_t i = first; i < out->length; i++)
+        cs_push(&cs, out->data[i].value);
+
+    // pure ops never touch the scene or exec state
+    op->get(op->data, NULL, NULL, &cs);
+
+    out->length = first;
+    emit(out, I_NUMBER, cs_pop(&cs));
+    return true;
+}
+
+// compile a single sub command, processing words from right to left
+static void compile_sub(const tele_command_t *c, uint8_t start, uint8_t end,
+                        tele_bytecode_t *out) {
+    const uint8_t sub_start = out->length;
+
+    // validate guarantees that every op consumes and produces a fixed number of
+    // values, so we can track the stack depth here rather than at run time
+    int16_t stack_depth = 0;
+
+    for (int16_t idx = end; idx >= start; idx--) {
+        const tele_word_t word_type = command_tag(c, idx);
+        const int16_t word_value = command_value(c, idx);
+
+        if (word_type == NUMBER) {
+            emit(out, I_NUMBER, word_value);
+            stack_depth++;
+        }
+        else if (word_type == OP) {
+            const uint8_t params = tele_op_params[word_value];
+            const uint8_t flags = tele_op_flags[word_value];
+
+            // if we're in the first command position, and there is a set fn
+            // pointer and we have enough params, then run set, else run get
+            if (idx == start && flags & OP_FLAG_SET &&
+                stack_depth >= params + 1) {
+                emit_set(out, word_value);
+                stack_depth -= params + 1;
+            }
+            else {
+                if (!(flags & OP_FLAG_PURE) ||
+                    !fold_pure_op(out, sub_start, tele_ops[word_value]))
+                    emit_get(out, word_value);
+                stack_depth -= params;
+                if (flags & OP_FLAG_RETURNS) stack_depth++;
+            }
+        }
+        else if (word_type == MOD) {
+            emit(out, I_MOD, word_value);
+            stack_depth = 0;
+        }
+
+        // folding only ever lowers the depth at run time, so this is an upper
+        // bound
+        if (stack_depth > out->stack_depth) out->stack_depth = stack_depth;
+    }
+}
+
+// compile all the sub commands between start and end (exclusive), empty sub
+// commands are skipped
+static void compile_subs(const tele_command_t *c, uint8_t start, uint8_t end,
+                         tele_bytecode_t *out) {
+    uint8_t sub_start = start;
+    bool first = true;
+
+    for (uint8_t idx = start; idx <= end; idx++) {
+        if (idx == end || command_tag(c, idx) == SUB_SEP) {
+            if (idx > sub_start) {
+                if (!first) emit(out, I_SUB_SEP, 0);
+                compile_sub(c, sub_start, idx - 1, out);
+                first = false;
+            }
+            sub_start = idx + 1;
+        }
+    }
+}
+
+void compile_command_unfused(const tele_command_t *c, tele_bytecode_t *out) {
+    out->length = 0;
+    out->separator = -1;
+    out->stack_depth = 0;
+
+    // if we have a PRE separator, the MOD ends up as the last instruction of
+    // the PRE part and the POST part follows on directly after it
+    if (c->separator == -1) { compile_subs(c, 0, c->length, out); }
+    else {
+        compile_subs(c, 0, c->separator, out);
+        out->separator = out->length;
+        compile_subs(c, c->separator + 1, c->length, out);
+    }
+
+    // validate rejects these, but scenes saved by older versions may still
+    // contain them, and the executor doesn't check the stack bounds
+    if (out->stack_depth > STACK_SIZE) {
+        out->length = 0;
+        out->separator = -1;
+    }
+}
+
+void compile_command(const tele_command_t *c, tele_bytecode_t *out) {
+    compile_command_unfused(c, out);
+    lower_loop_idioms(out);
+    fuse_bytecode(out, NULL);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// FUSION //////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// Common sequences of instructions are replaced by a single superinstruction
+// (plus an operand), saving a trip through the dispatch loop for each
+// instruction removed. Patterns are matched on tags only, the fuse fn then
+// checks the values, writes the replacement to out and returns its length, or
+// returns 0 if the sequence can't be fused after all. Fusions can never make
+// a command longer, and as I_MOD and I_SUB_SEP aren't used in any pattern, a
+// fusion never crosses the separator or a sub command.
+//
+// Run `make fusion_stats` in tests to see how often each of these is used in
+// a corpus of scenes, along with the most common unfused sequences.
+
+#define FUSION_MAX_LENGTH 4
+
+typedef struct {
+    const char *name;
+    uint8_t length;
+    uint8_t tags[FUSION_MAX_LENGTH];
+    uint8_t (*fuse)(const tele_instr_t *in, tele_instr_t *out);
+} fusion_t;
+
+static uint8_t fuse_2(tele_instr_t *out, tele_instr_tag_t tag, int16_t value,
+                      int16_t operand) {
+    out[0].tag = tag;
+    out[0].value = value;
+    out[1].tag = I_OPERAND;
+    out[1].value = operand;
+    return 2;
+}
+
+// X ADD X n (with the number pushed first)
+static uint8_t fuse_number_peek_add_poke(const tele_instr_t *in,
+                                         tele_instr_t *out) {
+    if (in[1].value != in[3].value) return 0;
+    return fuse_2(out, I_ADD_TO_VAR, in[1].value, in[0].value);
+}
+
+// X ADD n X (with the variable pushed first)
+static uint8_t fuse_peek_number_add_poke(const tele_instr_t *in,
+                                         tele_instr_t *out) {
+    if (in[0].value != in[3].value) return 0;
+    return fuse_2(out, I_ADD_TO_VAR, in[0].value, in[1].value);
+}
+
+// X SUB X n
+static uint8_t fuse_number_peek_sub_poke(const tele_instr_t *in,
+                                         tele_instr_t *out) {
+    if (in[1].value != in[3].value) return 0;
+    return fuse_2(out, I_ADD_TO_VAR, in[1].value, -in[0].value);
+}
+
+// X n
+static uint8_t fuse_number_poke(const tele_instr_t *in, tele_instr_t *out) {
+    return fuse_2(out, I_NUMBER_POKE, in[1].value, in[0].value);
+}
+
+// e.g. TR.PULSE 1
+static uint8_t fuse_number_get(const tele_instr_t *in, tele_instr_t *out) {
+    return fuse_2(out, I_NUMBER_GET, in[1].value, in[0].value);
+}
+
+// e.g. CV 1 N 12
+static uint8_t fuse_number_set(const tele_instr_t *in, tele_instr_t *out) {
+    return fuse_2(out, I_NUMBER_SET, in[1].value, in[0].value);
+}
+
+// clang-format off
+static const fusion_t fusions[] = {
+    { "X ADD X n", 4, { I_NUMBER, I_PEEK, I_ADD, I_POKE }, fuse_number_peek_add_poke },
+    { "X ADD n X", 4, { I_PEEK, I_NUMBER, I_ADD, I_POKE }, fuse_peek_number_add_poke },
+    { "X SUB X n", 4, { I_NUMBER, I_PEEK, I_SUB, I_POKE }, fuse_number_peek_sub_poke },
+    { "X n",       2, { I_NUMBER, I_POKE },                fuse_number_poke },
+    { "OP n",      2, { I_NUMBER, I_GET },                 fuse_number_get },
+    { "OP n m",    2, { I_NUMBER, I_SET },                 fuse_number_set },
+};
+// clang-format on
+
+#define FUSION_COUNT (sizeof(fusions) / sizeof(fusions[0]))
+
+static bool fusion_matches(const fusion_t *f, const tele_bytecode_t *bc,
+                           uint8_t idx) {
+    if (idx + f->length > bc->length) return false;
+    for (uint8_t i = 0; i < f->length; i++)
+        if (bc->data[idx + i].tag != f->tags[i]) return false;
+    return true;
+}
+
+static bool is_pattern_loop(const tele_bytecode_t *bc) {
+    return bc->separator > 0 &&
+           bc->data[bc->separator - 1].tag == I_PATTERN_LOOP;
+}
+
+void fuse_bytecode(tele_bytecode_t *bc, uint16_t *counts) {
+    tele_bytecode_t out;
+    out.length = 0;
+    out.separator = -1;
+    out.stack_depth = bc->stack_depth;
+
+    // the post command of a pattern loop is matched again when it's run, so
+    // it must be left as it is
+    const uint8_t fuse_end = is_pattern_loop(bc) ? bc->separator : bc->length;
+
+    uint8_t idx = 0;
+    while (idx < bc->length) {
+        if (idx == bc->separator) out.separator = out.length;
+
+        uint8_t f = idx < fuse_end ? 0 : FUSION_COUNT;
+        for (; f < FUSION_COUNT; f++) {
+            const fusion_t *fusion = &fusions[f];
+            if (!fusion_matches(fusion, bc, idx)) continue;
+
+            const uint8_t len =
+                fusion->fuse(&bc->data[idx], &out.data[out.length]);
+            if (len) {
+                out.length += len;
+                idx += fusion->length;
+                if (counts) counts[f]++;
+                break;
+            }
+        }
+
+        if (f == FUSION_COUNT) out.data[out.length++] = bc->data[idx++];
+    }
+    if (idx == bc->separator) out.separator = out.length;
+
+    memcpy(bc, &out, sizeof(tele_bytecode_t));
+}
+
+uint8_t fusion_count() {
+    return FUSION_COUNT;
+}
+
+const char *fusion_name(uint8_t idx) {
+    return fusions[idx].name;
+}
+
+void copy_command_view(tele_bytecode_t *dst, const tele_command_view_t *src) {
+    dst->length = src->end - src->start;
+    dst->separator = -1;
+    dst->stack_depth = src->bytecode->stack_depth;
+    memcpy(dst->data, &src->bytecode->data[src->start],
+           dst->length * sizeof(tele_instr_t));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// LOOP IDIOMS /////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// An L whose post command sets a pattern value at an index of I plus a constant
+// (e.g. L 0 63: P I 0 or L 0 15: PN 1 I RAND 7) has its I_MOD replaced by
+// I_PATTERN_LOOP, which runs the whole loop in a single call to p_loop (in
+// ops/patterns.c) rather than interpreting the post command once per pass.
+//
+// Only post commands that can't have any effect other than setting the pattern
+// (and using up random numbers) are matched, anything else (e.g. ii ops, DEL
+// or SCRIPT) is left to the interpreter. The post command is kept, unfused, as
+// it's matched again to get the loop each time it's run, if that match ever
+// fails the executor falls back to running it as an ordinary L.
+
+// matching works backwards from the end of the post command, as that's where
+// the op that sets the pattern is, each fn moves *end back past the
+// instructions it matches
+
+static bool is_i(const tele_instr_t *instr) {
+    return instr->tag == I_PEEK &&
+           instr->value == (int16_t)(size_t)op_I.data;
+}
+
+// I, + I n, + n I or - I n
+static bool match_index(const tele_instr_t *start, const tele_instr_t **end,
+                        int16_t *offset) {
+    const tele_instr_t *in = *end;
+
+    if (in - start >= 3 && (in[-1].tag == I_ADD || in[-1].tag == I_SUB)) {
+        const tele_instr_t *i = &in[-2], *n = &in[-3];
+        if (in[-1].tag == I_ADD && !is_i(i)) {
+            i = &in[-3];
+            n = &in[-2];
+        }
+        if (!is_i(i) || n->tag != I_NUMBER) return false;
+        *offset = in[-1].tag == I_ADD ? n->value : -n->value;
+        *end = in - 3;
+        return true;
+    }
+
+    if (in - start >= 1 && is_i(&in[-1])) {
+        *offset = 0;
+        *end = in - 1;
+        return true;
+    }
+
+    return false;
+}
+
+// ops that only read their params and the random number generator
+static bool is_random_op(const tele_op_t *op) {
+    return op->get == op_RAND.get || op->get == op_RRAND.get ||
+           op->get == op_TOSS.get;
+}
+
+// P or PN at an index, pn is -1 for P
+static bool match_pattern(const tele_instr_t *start, const tele_instr_t **end,
+                          const tele_instr_t *op, int16_t *pn,
+                          int16_t *offset) {
+    if (tele_ops[op->value]->get == op_P.get) { *pn = -1; }
+    else {
+        if (*end == start || (*end)[-1].tag != I_NUMBER) return false;
+        // p_loop limits the pattern number, but -1 is taken
+        *pn = (*end)[-1].value < 0 ? 0 : (*end)[-1].value;
+        (*end)--;
+    }
+    return match_index(start, end, offset);
+}
+
+static bool match_value(const tele_instr_t *start, const tele_instr_t **end,
+                        pattern_loop_t *loop) {
+    if (match_index(start, end, &loop->value)) {
+        loop->value_type = LOOP_VALUE_I;
+        return true;
+    }
+    if (*end == start) return false;
+
+    const tele_instr_t *in = --(*end);
+    loop->value = in->value;
+
+    if (in->tag == I_NUMBER) {
+        loop->value_type = LOOP_VALUE_NUMBER;
+        return true;
+    }
+    else if (in->tag == I_PEEK) {
+        // the post command can't set a variable, so it's the same on every
+        // pass
+        loop->value_type = LOOP_VALUE_VARIABLE;
+        return true;
+    }
+    else if (in->tag != I_GET) {
+        return false;
+    }
+
+    const tele_op_t *op = tele_ops[in->value];
+    if (op->get == op_P.get || op->get == op_PN.get) {
+        loop->value_type = LOOP_VALUE_PATTERN;
+        return match_pattern(start, end, in, &loop->src, &loop->value);
+    }
+    else if (is_random_op(op) && op->params <= 2 &&
+             *end - start >= op->params) {
+        loop->value_type = LOOP_VALUE_OP;
+        loop->params = op->params;
+        for (uint8_t i = 0; i < op->params; i++) {
+            const tele_instr_t *arg = &(*end)[i - op->params];
+            if (arg->tag != I_NUMBER) return false;
+            loop->args[i] = arg->value;
+        }
+        *end -= op->params;
+        return true;
+    }
+
+    return false;
+}
+
+bool match_pattern_loop(const tele_command_view_t *post, pattern_loop_t *loop) {
+    const tele_instr_t *start = &post->bytecode->data[post->start];
+    const tele_instr_t *end = &post->bytecode->data[post->end];
+    if (end == start) return false;
+
+    const tele_instr_t *set = --end;
+    if (set->tag != I_SET) return false;
+    if (tele_ops[set->value]->set != op_P.set &&
+        tele_ops[set->value]->set != op_PN.set)
+        return false;
+
+    // the whole of the post command must have been matched
+    return match_pattern(start, &end, set, &loop->dst, &loop->dst_offset) &&
+           match_value(start, &end, loop) && end == start;
+}
+
+void lower_loop_idioms(tele_bytecode_t *bc) {
+    if (bc->separator < 1) return;
+    tele_instr_t *mod = &bc->data[bc->separator - 1];
+    if (mod->tag != I_MOD || tele_mods[mod->value] != &mod_L) return;
+
+    const tele_command_view_t post = {
+        .bytecode = bc, .start = bc->separator, .end = bc->length
+    };
+    pattern_loop_t loop;
+    if (match_pattern_loop(&post, &loop)) mod->tag = I_PATTERN_LOOP;
+}
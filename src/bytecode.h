@@ -0,0 +1,110 @@
+#ifndef _BYTECODE_H_
+#define _BYTECODE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "command.h"
+
+// A compiled command can never be longer than its source, every word compiles
+// to at most one instruction
+#define BYTECODE_MAX_LENGTH COMMAND_MAX_LENGTH
+
+typedef enum {
+    I_NUMBER,   // push value onto the stack
+    I_GET,      // call the get fn of tele_ops[value]
+    I_SET,      // call the set fn of tele_ops[value]
+    I_MOD,      // call tele_mods[value] with the post command
+    I_SUB_SEP,  // start a new sub command (empties the stack)
+
+    // the most frequently used ops are compiled to their own instructions so
+    // that the executor can run them inline, rather than via tele_ops
+    I_PEEK,  // simple variable get, value is the offset into scene_state_t
+    I_POKE,  // simple variable set, value is the offset into scene_state_t
+    I_ADD,
+    I_SUB,
+    I_EQ,
+    I_NE,
+    I_LT,
+    I_GT,
+    I_SCRIPT,  // call a script without recursing, see exec_frame_t
+    I_PATTERN_LOOP,  // replaces the I_MOD of an L that only writes to a
+                     // pattern, see loop idioms in bytecode.c
+
+    // superinstructions, these are followed by an I_OPERAND, see fusions in
+    // bytecode.c
+    I_ADD_TO_VAR,  // add the operand to the simple variable at offset value
+    I_NUMBER_GET,  // push the operand and call the get fn of tele_ops[value]
+    I_NUMBER_SET,  // push the operand and call the set fn of tele_ops[value]
+    I_NUMBER_POKE,  // set the simple variable at offset value to the operand
+    I_OPERAND,     // never run, holds the 2nd value of the previous instruction
+
+    I__LENGTH
+} tele_instr_tag_t;
+
+typedef struct {
+    uint8_t tag;
+    int16_t value;
+} tele_instr_t;
+
+// Instructions are stored in the order they are executed (i.e. each sub command
+// has been reversed), so that the executor can run them in a single pass. If
+// there is a MOD it is the last instruction before separator, and the post
+// command starts at separator and runs to the end.
+typedef struct {
+    uint8_t length;
+    int8_t separator;
+    uint8_t stack_depth;  // the most values on the stack in any sub command
+    tele_instr_t data[BYTECODE_MAX_LENGTH];
+} tele_bytecode_t;
+
+// A view of the instructions from start up to (but not including) end of a
+// compiled command, used to run part of it (e.g. the post command of a MOD) in
+// place without copying it.
+typedef struct {
+    const tele_bytecode_t *bytecode;
+    uint8_t start;
+    uint8_t end;
+} tele_command_view_t;
+
+// The post command of an L that has been compiled to I_PATTERN_LOOP, on each
+// pass of the loop it sets the value at I + dst_offset of the pattern dst
+typedef enum {
+    LOOP_VALUE_NUMBER,    // value
+    LOOP_VALUE_VARIABLE,  // the simple variable at offset value
+    LOOP_VALUE_I,         // I + value
+    LOOP_VALUE_PATTERN,   // the value at I + value of the pattern src
+    LOOP_VALUE_OP         // tele_ops[value] with params args (e.g. RAND 7)
+} pattern_loop_value_t;
+
+typedef struct {
+    int16_t dst;  // pattern number, or -1 for the working pattern (P.N)
+    int16_t dst_offset;
+    uint8_t value_type;  // pattern_loop_value_t
+    int16_t value;
+    int16_t src;  // as dst
+    uint8_t params;
+    int16_t args[2];  // in the order they are pushed
+} pattern_loop_t;
+
+// c must have been validated, if it would need more than STACK_SIZE values
+// on the stack (only possible for commands saved by older versions) it is
+// compiled to an empty command instead
+void compile_command(const tele_command_t *c, tele_bytecode_t *out);
+
+// compile_command is compile_command_unfused followed by lower_loop_idioms and
+// fuse_bytecode, they are available separately to allow the fusions to be
+// measured (see tests/fusion_stats.c), if counts is not NULL it must have
+// fusion_count() entries, each is incremented every time that fusion is made
+void compile_command_unfused(const tele_command_t *c, tele_bytecode_t *out);
+void lower_loop_idioms(tele_bytecode_t *bc);
+void fuse_bytecode(tele_bytecode_t *bc, uint16_t *counts);
+// returns true if post is the post command of an L that can be run as an
+// I_PATTERN_LOOP, filling in loop
+bool match_pattern_loop(const tele_command_view_t *post, pattern_loop_t *loop);
+uint8_t fusion_count(void);
+const char *fusion_name(uint8_t idx);
+// dst has no separator, the view must not contain a MOD
+void copy_command_view(tele_bytecode_t *dst, const tele_command_view_t *src);
+
+#endif
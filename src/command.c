@@ -1,27 +1,38 @@
 #include "command.h"
 
-#include <string.h>  // memcpy
+#include <string.h>  // strcat
 
 #include "ops/op.h"
 #include "util.h"
 
-void copy_command(tele_command_t *dst, const tele_command_t *src) {
-    // TODO does this need to use memcpy?
-    memcpy(dst, src, sizeof(tele_command_t));
+void command_init(tele_command_t *c) {
+    c->length = 0;
+    c->separator = -1;
+    c->wide_length = 0;
 }
 
-void copy_post_command(tele_command_t *dst, const tele_command_t *src) {
-    dst->length = src->length - src->separator - 1;
-    dst->separator = -1;
-    memcpy(dst->data, &src->data[src->separator + 1],
-           dst->length * sizeof(tele_data_t));
+bool command_append(tele_command_t *c, tele_word_t tag, int16_t value) {
+    if (c->length >= COMMAND_MAX_LENGTH) return false;
+
+    uint16_t packed_tag = tag;
+    uint16_t packed_value = value & COMMAND_VALUE_MASK;
+    if (tag == NUMBER &&
+        (value < COMMAND_NUMBER_MIN || value > COMMAND_NUMBER_MAX)) {
+        if (c->wide_length >= COMMAND_MAX_WIDE) return false;
+        c->wide[c->wide_length] = value;
+        packed_tag = COMMAND_WIDE_NUMBER;
+        packed_value = c->wide_length++;
+    }
+
+    c->data[c->length++] = packed_tag << COMMAND_TAG_SHIFT | packed_value;
+    return true;
 }
 
 void print_command(const tele_command_t *cmd, char *out) {
     out[0] = 0;
     for (size_t i = 0; i < cmd->length; i++) {
-        tele_word_t tag = cmd->data[i].tag;
-        int16_t value = cmd->data[i].value;
+        tele_word_t tag = command_tag(cmd, i);
+        int16_t value = command_value(cmd, i);
 
         switch (tag) {
             case OP: strcat(out, tele_ops[value]->name); break;
@@ -40,7 +51,7 @@ void print_command(const tele_command_t *cmd, char *out) {
         // first check if we're not at the end
         if (i < cmd->length - 1) {
             // otherwise, only add a space if the next tag is a not a seperator
-            tele_word_t next_tag = cmd->data[i + 1].tag;
+            tele_word_t next_tag = command_tag(cmd, i + 1);
             if (next_tag != PRE_SEP && next_tag != SUB_SEP) {
                 strcat(out, " ");
             }
@@ -1,25 +1,68 @@
 #ifndef _COMMAND_H_
 #define _COMMAND_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define COMMAND_MAX_LENGTH 12
+// the most numbers outside of COMMAND_NUMBER_MIN to COMMAND_NUMBER_MAX that
+// a command can contain, parse allows 11 words and no valid command has more
+// than 9 numbers in them (e.g. SCALE SCALE 1 2 3 4 5 6 7 8 9, as saved by
+// older versions), so any command that would need more is rejected anyway
+#define COMMAND_MAX_WIDE 9
 
 typedef enum { NUMBER, OP, MOD, PRE_SEP, SUB_SEP } tele_word_t;
 
+// a single unpacked word, see command_get and command_append
 typedef struct {
     tele_word_t tag;
     int16_t value;
 } tele_data_t;
 
+// Commands are stored in scripts, the live mode history and flash, so each
+// word is packed into 16 bits, the tag in the top 3 bits and the value in the
+// other 13. Numbers that don't fit in 13 bits are stored in wide instead, with
+// the word holding their index. Use the functions below rather than accessing
+// data directly.
+#define COMMAND_TAG_SHIFT 13
+#define COMMAND_VALUE_MASK 0x1FFF
+#define COMMAND_NUMBER_MIN -4096
+#define COMMAND_NUMBER_MAX 4095
+#define COMMAND_WIDE_NUMBER 7  // packed tag for a number stored in wide
+
 typedef struct {
     uint8_t length;
     int8_t separator;
-    tele_data_t data[COMMAND_MAX_LENGTH];
+    uint8_t wide_length;
+    uint16_t data[COMMAND_MAX_LENGTH];
+    int16_t wide[COMMAND_MAX_WIDE];
 } tele_command_t;
 
-void copy_command(tele_command_t *dst, const tele_command_t *src);
-void copy_post_command(tele_command_t *dst, const tele_command_t *src);
+static inline tele_word_t command_tag(const tele_command_t *c, uint8_t idx) {
+    const uint8_t tag = c->data[idx] >> COMMAND_TAG_SHIFT;
+    return tag == COMMAND_WIDE_NUMBER ? NUMBER : (tele_word_t)tag;
+}
+
+static inline int16_t command_value(const tele_command_t *c, uint8_t idx) {
+    const uint16_t word = c->data[idx];
+    const int16_t value = word & COMMAND_VALUE_MASK;
+    if (word >> COMMAND_TAG_SHIFT == COMMAND_WIDE_NUMBER)
+        return c->wide[value];
+    else if (word >> COMMAND_TAG_SHIFT == NUMBER && value > COMMAND_NUMBER_MAX)
+        return value - (COMMAND_VALUE_MASK + 1);  // sign extend
+    else
+        return value;
+}
+
+static inline tele_data_t command_get(const tele_command_t *c, uint8_t idx) {
+    tele_data_t d = { command_tag(c, idx), command_value(c, idx) };
+    return d;
+}
+
+void command_init(tele_command_t *c);
+// returns false if there is no room left for the word
+bool command_append(tele_command_t *c, tele_word_t tag, int16_t value);
+
 void print_command(const tele_command_t *c, char *out);
 
 #endif
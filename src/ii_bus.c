@@ -0,0 +1,353 @@
+#include "ii_bus.h"
+
+#include <string.h>
+
+#include "state.h"
+#include "teletype_io.h"
+
+static struct {
+    ii_transfer_t transfers[II_TRANSFER_QUEUE_LENGTH];
+    uint8_t head;  // the oldest transfer, which is on the bus once started
+    uint8_t count;
+    bool started;
+    uint32_t start_time;
+} bus;
+
+static struct {
+    ii_tx_message_t messages[II_TX_QUEUE_LENGTH];
+    uint8_t count;
+    uint8_t depth;
+    int8_t source;
+    uint32_t merged;
+} queue = {.source = II_SOURCE_NONE };
+
+typedef struct {
+    uint8_t addr;
+    uint8_t request_l;
+    uint8_t request[II_CACHE_MAX_LENGTH];
+    uint8_t l;
+    uint8_t data[II_CACHE_MAX_LENGTH];
+    bool used;
+    bool valid;
+    bool pending;
+    uint8_t generation;  // changed whenever the cached value is out of date
+    uint8_t pending_generation;
+    uint8_t age;  // the number of refreshes since it was last read
+} cache_entry_t;
+
+static struct {
+    cache_entry_t entries[II_CACHE_LENGTH];
+    uint16_t poll_ms;
+    uint32_t last_poll;
+} cache = {.poll_ms = II_POLL_MS };
+
+static void refresh_cache(uint32_t now);
+static void invalidate_cache(uint8_t addr);
+
+
+/////////////////////////////////////////////////////////////////
+// TRANSFERS ////////////////////////////////////////////////////
+
+ii_transfer_t *ii_submit(uint8_t addr, bool read, const uint8_t *data,
+                         uint8_t l, ii_callback_t callback, void *context) {
+    if (bus.count == II_TRANSFER_QUEUE_LENGTH || l > II_TX_MAX_LENGTH)
+        return NULL;
+
+    const uint8_t i = (bus.head + bus.count++) % II_TRANSFER_QUEUE_LENGTH;
+    ii_transfer_t *t = &bus.transfers[i];
+    t->addr = addr;
+    t->read = read;
+    t->l = l;
+    if (read)
+        memset(t->data, 0, l);
+    else
+        memcpy(t->data, data, l);
+    t->status = II_PENDING;
+    t->source = queue.source;
+    t->callback = callback;
+    t->context = context;
+    return t;
+}
+
+static void finish_transfer(ii_transfer_t *t, ii_status_t status) {
+    t->status = status;
+    bus.started = false;
+    bus.head = (bus.head + 1) % II_TRANSFER_QUEUE_LENGTH;
+    bus.count--;
+    if (t->callback) t->callback(t);
+}
+
+// runs the bus, but without refreshing the cache, for use while waiting
+static void poll_bus(uint32_t now) {
+    if (bus.started) {
+        if (now - bus.start_time < II_TIMEOUT_MS * TICKS_PER_MS) return;
+        finish_transfer(&bus.transfers[bus.head], II_TIMEOUT);
+    }
+
+    // a target that finishes each transfer in tele_ii_start sends the whole
+    // queue here
+    while (bus.count && !bus.started) {
+        bus.started = true;
+        bus.start_time = now;
+        tele_ii_start(&bus.transfers[bus.head]);
+    }
+}
+
+void ii_poll(uint32_t now) {
+    refresh_cache(now);
+    poll_bus(now);
+}
+
+void ii_transfer_done(ii_transfer_t *t, ii_status_t status) {
+    // it may have already timed out
+    if (!bus.started || t != &bus.transfers[bus.head]) return;
+    finish_transfer(t, status);
+}
+
+void ii_wait() {
+    while (bus.count) poll_bus(tele_get_ticks());
+}
+
+bool ii_busy() {
+    return bus.count > 0;
+}
+
+// wait for room in the queue if needed, which there will be once the oldest
+// transfer has finished or timed out
+static ii_transfer_t *submit_waiting(uint8_t addr, bool read,
+                                     const uint8_t *data, uint8_t l) {
+    ii_transfer_t *t;
+    while (!(t = ii_submit(addr, read, data, l, NULL, NULL)))
+        poll_bus(tele_get_ticks());
+    return t;
+}
+
+
+/////////////////////////////////////////////////////////////////
+// TX QUEUE /////////////////////////////////////////////////////
+
+static void queue_message(uint8_t addr, uint8_t *data, uint8_t l, bool set) {
+    // too long to send
+    if (l > II_TX_MAX_LENGTH) return;
+
+    if (queue.count == II_TX_QUEUE_LENGTH) ii_tx_flush();
+
+    ii_tx_message_t *m = &queue.messages[queue.count++];
+    m->addr = addr;
+    m->l = l;
+    m->set = set;
+    memcpy(m->data, data, l);
+}
+
+void ii_tx(uint8_t addr, uint8_t *data, uint8_t l) {
+    invalidate_cache(addr);
+    if (queue.depth == 0) {
+        if (l > II_TX_MAX_LENGTH) return;
+        submit_waiting(addr, false, data, l);
+        poll_bus(tele_get_ticks());
+        return;
+    }
+
+    queue_message(addr, data, l, false);
+}
+
+void ii_tx_set(uint8_t addr, uint8_t *data, uint8_t l) {
+    invalidate_cache(addr);
+    if (queue.depth == 0) {
+        if (l > II_TX_MAX_LENGTH) return;
+        submit_waiting(addr, false, data, l);
+        poll_bus(tele_get_ticks());
+        return;
+    }
+
+    // a set needs a command and a parameter to be merged with an earlier one
+    if (l < 2) {
+        queue_message(addr, data, l, false);
+        return;
+    }
+
+    // the earlier set keeps its place in the queue, with the new value, unless
+    // another write to the follower (e.g. a trigger) has been queued since, as
+    // it must still see the earlier value
+    for (uint8_t i = queue.count; i-- > 0;) {
+        ii_tx_message_t *m = &queue.messages[i];
+        if (m->addr != addr) continue;
+        if (!m->set) break;
+        if (m->l == l && m->data[0] == data[0] && m->data[1] == data[1]) {
+            memcpy(m->data, data, l);
+            queue.merged++;
+            return;
+        }
+    }
+
+    queue_message(addr, data, l, true);
+}
+
+void ii_rx(uint8_t addr, uint8_t *data, uint8_t l) {
+    if (l > II_TX_MAX_LENGTH) return;
+    ii_tx_flush();
+
+    // the transfers are run in order, so those before it are done too
+    ii_transfer_t *t = submit_waiting(addr, true, NULL, l);
+    while (t->status == II_PENDING) poll_bus(tele_get_ticks());
+    if (t->status == II_OK) memcpy(data, t->data, l);
+}
+
+void ii_tx_begin(int8_t source) {
+    if (queue.depth++ == 0) queue.source = source;
+}
+
+void ii_tx_end() {
+    if (queue.depth == 0) return;
+    if (--queue.depth) return;
+    ii_tx_flush();
+    queue.source = II_SOURCE_NONE;
+}
+
+void ii_tx_flush() {
+    if (queue.count == 0) return;
+    for (uint8_t i = 0; i < queue.count; i++) {
+        ii_tx_message_t *m = &queue.messages[i];
+        submit_waiting(m->addr, false, m->data, m->l);
+    }
+    queue.count = 0;
+    // there's nothing to gain by waiting for the main loop to start them
+    poll_bus(tele_get_ticks());
+}
+
+uint32_t ii_tx_merged() {
+    return queue.merged;
+}
+
+
+/////////////////////////////////////////////////////////////////
+// INPUT CACHE //////////////////////////////////////////////////
+
+static cache_entry_t *find_entry(uint8_t addr, const uint8_t *request,
+                                 uint8_t request_l, uint8_t l) {
+    for (uint8_t i = 0; i < II_CACHE_LENGTH; i++) {
+        cache_entry_t *e = &cache.entries[i];
+        if (e->used && e->addr == addr && e->request_l == request_l &&
+            e->l == l && memcmp(e->request, request, request_l) == 0)
+            return e;
+    }
+    return NULL;
+}
+
+static cache_entry_t *add_entry(uint8_t addr, const uint8_t *request,
+                                uint8_t request_l, uint8_t l) {
+    for (uint8_t i = 0; i < II_CACHE_LENGTH; i++) {
+        cache_entry_t *e = &cache.entries[i];
+        if (e->used) continue;
+        e->used = true;
+        e->addr = addr;
+        e->request_l = request_l;
+        memcpy(e->request, request, request_l);
+        e->l = l;
+        e->valid = false;
+        e->pending = false;
+        // a refresh for the entry's previous input may still be on the bus
+        e->generation++;
+        return e;
+    }
+    return NULL;
+}
+
+// the follower is told what to read, then read from
+static void read_now(uint8_t addr, const uint8_t *request, uint8_t request_l,
+                     uint8_t *data, uint8_t l) {
+    ii_tx_flush();
+    submit_waiting(addr, false, request, request_l);
+    ii_rx(addr, data, l);
+}
+
+void ii_read(uint8_t addr, const uint8_t *request, uint8_t request_l,
+             uint8_t *data, uint8_t l) {
+    if (cache.poll_ms == 0 || request_l > II_CACHE_MAX_LENGTH ||
+        l > II_CACHE_MAX_LENGTH) {
+        read_now(addr, request, request_l, data, l);
+        return;
+    }
+
+    cache_entry_t *e = find_entry(addr, request, request_l, l);
+    if (!e) e = add_entry(addr, request, request_l, l);
+    if (!e) {
+        read_now(addr, request, request_l, data, l);
+        return;
+    }
+
+    e->age = 0;
+    if (!e->valid) {
+        read_now(addr, request, request_l, e->data, l);
+        e->valid = true;
+    }
+    memcpy(data, e->data, l);
+}
+
+static void cache_refreshed(ii_transfer_t *t) {
+    cache_entry_t *e = t->context;
+    e->pending = false;
+    // a write since the refresh was queued may have changed it
+    if (t->status != II_OK || e->pending_generation != e->generation) return;
+    memcpy(e->data, t->data, e->l);
+    e->valid = true;
+}
+
+static void refresh_entries() {
+    for (uint8_t i = 0; i < II_CACHE_LENGTH; i++) {
+        cache_entry_t *e = &cache.entries[i];
+        if (!e->used || e->pending) continue;
+
+        // stop polling inputs that aren't being read anymore
+        if (++e->age > II_CACHE_EXPIRE) {
+            e->used = false;
+            continue;
+        }
+
+        if (!ii_submit(e->addr, false, e->request, e->request_l, NULL, NULL))
+            return;
+        if (!ii_submit(e->addr, true, NULL, e->l, cache_refreshed, e)) return;
+        e->pending = true;
+        e->pending_generation = e->generation;
+    }
+}
+
+static void refresh_cache(uint32_t now) {
+    if (cache.poll_ms == 0) return;
+    if (now - cache.last_poll < (uint32_t)cache.poll_ms * TICKS_PER_MS) return;
+    cache.last_poll = now;
+    refresh_entries();
+}
+
+static void invalidate_cache(uint8_t addr) {
+    for (uint8_t i = 0; i < II_CACHE_LENGTH; i++) {
+        cache_entry_t *e = &cache.entries[i];
+        if (!e->used || e->addr != addr) continue;
+        e->valid = false;
+        e->generation++;
+    }
+}
+
+void ii_refresh() {
+    ii_tx_flush();
+    refresh_entries();
+    ii_wait();
+}
+
+void ii_cache_clear() {
+    for (uint8_t i = 0; i < II_CACHE_LENGTH; i++)
+        cache.entries[i].used = false;
+    // the first refresh is a whole II.POLL after the cache was cleared
+    cache.last_poll = tele_get_ticks();
+}
+
+uint16_t ii_get_poll_ms() {
+    return cache.poll_ms;
+}
+
+void ii_set_poll_ms(uint16_t ms) {
+    if (ms == cache.poll_ms) return;
+    cache.poll_ms = ms;
+    // values cached before the change may be from long ago
+    ii_cache_clear();
+}
@@ -0,0 +1,128 @@
+#ifndef _II_BUS_H_
+#define _II_BUS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ops send their ii messages through here rather than to the target directly,
+// so that the writes made while a script runs can be collected and sent once
+// it has finished, without waiting for the bus
+
+#define II_TX_QUEUE_LENGTH 16
+#define II_TX_MAX_LENGTH 8
+#define II_TRANSFER_QUEUE_LENGTH 32
+#define II_TIMEOUT_MS 5
+#define II_CACHE_LENGTH 16
+#define II_CACHE_MAX_LENGTH 2
+#define II_CACHE_EXPIRE 100
+// the cache is off until a scene turns it on with II.POLL, as it means a read
+// may give a value up to II.POLL ms old
+#define II_POLL_MS 0
+
+// the source of a transfer made outside of any script, e.g. the background
+// refreshes of the input cache
+#define II_SOURCE_NONE -2
+
+typedef struct {
+    uint8_t addr;
+    uint8_t l;
+    bool set;
+    uint8_t data[II_TX_MAX_LENGTH];
+} ii_tx_message_t;
+
+typedef enum { II_PENDING, II_OK, II_ERROR, II_TIMEOUT } ii_status_t;
+
+typedef struct ii_transfer_s ii_transfer_t;
+typedef void (*ii_callback_t)(ii_transfer_t *t);
+
+struct ii_transfer_s {
+    uint8_t addr;
+    bool read;
+    uint8_t l;
+    uint8_t data[II_TX_MAX_LENGTH];
+    ii_status_t status;
+    int8_t source;  // the script that queued it, see ii_tx_begin
+    ii_callback_t callback;
+    void *context;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// TRANSFERS ///////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// queue a transfer without waiting for it, returns NULL if the queue is full,
+// callback (if not NULL) is called once it has finished, with the data read
+// and the status, the transfer is only valid until then
+ii_transfer_t *ii_submit(uint8_t addr, bool read, const uint8_t *data,
+                         uint8_t l, ii_callback_t callback, void *context);
+
+// starts the queued transfers one at a time and times them out, the target
+// calls it from its main loop, now is from tele_get_ticks
+void ii_poll(uint32_t now);
+
+// called by the target when the transfer given to tele_ii_start has
+// finished, either from an interrupt or from tele_ii_start itself
+void ii_transfer_done(ii_transfer_t *t, ii_status_t status);
+
+// wait for the transfers queued so far to finish
+void ii_wait(void);
+
+bool ii_busy(void);
+
+////////////////////////////////////////////////////////////////////////////////
+// SCRIPTS /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// a write, sent in order with the other writes and reads
+void ii_tx(uint8_t addr, uint8_t *data, uint8_t l);
+
+// a write that sets the value of a remote output, data[0] is the command and
+// data[1] the port, it replaces an earlier set of the same output still in
+// the queue (so only the last value set by a script is sent), as long as no
+// other write to the follower has been queued since
+void ii_tx_set(uint8_t addr, uint8_t *data, uint8_t l);
+
+// a read, which waits for the result, anything queued is sent first, data is
+// left as 0 if the read fails
+void ii_rx(uint8_t addr, uint8_t *data, uint8_t l);
+
+// writes are queued between ii_tx_begin and ii_tx_end, which nest, and are
+// sent by the outermost ii_tx_end (or by ii_tx_flush), outside of them every
+// write is sent straight away, in both cases the bus is started then rather
+// than at the next ii_poll, the transfers made in between are marked with
+// the source given to the outermost ii_tx_begin (the script, or -1 for a
+// command), so that the simulator can say which script used the bus
+void ii_tx_begin(int8_t source);
+void ii_tx_end(void);
+void ii_tx_flush(void);
+
+// the number of writes that were replaced by a later one, rather than sent
+uint32_t ii_tx_merged(void);
+
+////////////////////////////////////////////////////////////////////////////////
+// INPUT CACHE /////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// reads from remote inputs are cached, the first read of an input is made
+// straight away and subscribes to it, from then on it's refreshed in the
+// background by ii_poll every II.POLL ms, until it goes unread for
+// II_CACHE_EXPIRE refreshes, a write to the follower means the next read is
+// made straight away again
+
+// read l bytes from addr into data, after sending it request
+void ii_read(uint8_t addr, const uint8_t *request, uint8_t request_l,
+             uint8_t *data, uint8_t l);
+
+// refresh every cached input now, and wait for the results
+void ii_refresh(void);
+
+// forget every cached input, and start the next II.POLL interval from now,
+// called when a scene is loaded
+void ii_cache_clear(void);
+
+// 0 turns the cache off, every read is then made straight away, changing it
+// clears the cache
+uint16_t ii_get_poll_ms(void);
+void ii_set_poll_ms(uint16_t ms);
+
+#endif
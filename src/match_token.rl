@@ -46,9 +46,30 @@
         "M!"          => { MATCH_OP(E_OP_M_SYM_EXCLAMATION); };
         "M.ACT"       => { MATCH_OP(E_OP_M_ACT); };
         "M.RESET"     => { MATCH_OP(E_OP_M_RESET); };
+        "M.LATE"      => { MATCH_OP(E_OP_M_LATE); };
+        "M.POL"       => { MATCH_OP(E_OP_M_POL); };
+        "M.OVER"      => { MATCH_OP(E_OP_M_OVER); };
+        "M.LOAD"      => { MATCH_OP(E_OP_M_LOAD); };
+        "M1"          => { MATCH_OP(E_OP_M1); };
+        "M1.ACT"      => { MATCH_OP(E_OP_M1_ACT); };
+        "M1.RESET"    => { MATCH_OP(E_OP_M1_RESET); };
+        "M1.SCRIPT"   => { MATCH_OP(E_OP_M1_SCRIPT); };
+        "M2"          => { MATCH_OP(E_OP_M2); };
+        "M2.ACT"      => { MATCH_OP(E_OP_M2_ACT); };
+        "M2.RESET"    => { MATCH_OP(E_OP_M2_RESET); };
+        "M2.SCRIPT"   => { MATCH_OP(E_OP_M2_SCRIPT); };
+        "M3"          => { MATCH_OP(E_OP_M3); };
+        "M3.ACT"      => { MATCH_OP(E_OP_M3_ACT); };
+        "M3.RESET"    => { MATCH_OP(E_OP_M3_RESET); };
+        "M3.SCRIPT"   => { MATCH_OP(E_OP_M3_SCRIPT); };
+        "M4"          => { MATCH_OP(E_OP_M4); };
+        "M4.ACT"      => { MATCH_OP(E_OP_M4_ACT); };
+        "M4.RESET"    => { MATCH_OP(E_OP_M4_RESET); };
+        "M4.SCRIPT"   => { MATCH_OP(E_OP_M4_SCRIPT); };
 
         # patterns
         "P.N"         => { MATCH_OP(E_OP_P_N); };
+        "P.BANK"      => { MATCH_OP(E_OP_P_BANK); };
         "P"           => { MATCH_OP(E_OP_P); };
         "PN"          => { MATCH_OP(E_OP_PN); };
         "P.L"         => { MATCH_OP(E_OP_P_L); };
@@ -75,11 +96,31 @@
         "PN.PUSH"     => { MATCH_OP(E_OP_PN_PUSH); };
         "P.POP"       => { MATCH_OP(E_OP_P_POP); };
         "PN.POP"      => { MATCH_OP(E_OP_PN_POP); };
+        "P.REV"       => { MATCH_OP(E_OP_P_REV); };
+        "PN.REV"      => { MATCH_OP(E_OP_PN_REV); };
+        "P.ROT"       => { MATCH_OP(E_OP_P_ROT); };
+        "PN.ROT"      => { MATCH_OP(E_OP_PN_ROT); };
+        "P.SHUF"      => { MATCH_OP(E_OP_P_SHUF); };
+        "PN.SHUF"     => { MATCH_OP(E_OP_PN_SHUF); };
+        "P.SUM"       => { MATCH_OP(E_OP_P_SUM); };
+        "PN.SUM"      => { MATCH_OP(E_OP_PN_SUM); };
+        "P.MIN"       => { MATCH_OP(E_OP_P_MIN); };
+        "PN.MIN"      => { MATCH_OP(E_OP_PN_MIN); };
+        "P.MAX"       => { MATCH_OP(E_OP_P_MAX); };
+        "PN.MAX"      => { MATCH_OP(E_OP_PN_MAX); };
+        "P.FIND"      => { MATCH_OP(E_OP_P_FIND); };
+        "PN.FIND"     => { MATCH_OP(E_OP_PN_FIND); };
+        "P.ADD"       => { MATCH_OP(E_OP_P_ADD); };
+        "PN.ADD"      => { MATCH_OP(E_OP_PN_ADD); };
+        "P.SCALE"     => { MATCH_OP(E_OP_P_SCALE); };
+        "PN.SCALE"    => { MATCH_OP(E_OP_PN_SCALE); };
 
         # queue
         "Q"           => { MATCH_OP(E_OP_Q); };
         "Q.AVG"       => { MATCH_OP(E_OP_Q_AVG); };
         "Q.N"         => { MATCH_OP(E_OP_Q_N); };
+        "Q.MIN"       => { MATCH_OP(E_OP_Q_MIN); };
+        "Q.MAX"       => { MATCH_OP(E_OP_Q_MAX); };
 
         # hardware
         "CV"          => { MATCH_OP(E_OP_CV); };
@@ -97,6 +138,9 @@
         "CV.SET"      => { MATCH_OP(E_OP_CV_SET); };
         "MUTE"        => { MATCH_OP(E_OP_MUTE); };
         "STATE"       => { MATCH_OP(E_OP_STATE); };
+        "II.FLUSH"    => { MATCH_OP(E_OP_II_FLUSH); };
+        "II.POLL"     => { MATCH_OP(E_OP_II_POLL); };
+        "II.REFRESH"  => { MATCH_OP(E_OP_II_REFRESH); };
 
         # maths
         "ADD"         => { MATCH_OP(E_OP_ADD); };
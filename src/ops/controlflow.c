@@ -3,23 +3,24 @@
 #include <stdlib.h>
 
 #include "helpers.h"
+#include "ii_bus.h"
 #include "teletype.h"
 #include "teletype_io.h"
 
 static void mod_PROB_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_IF_func(scene_state_t *ss, exec_state_t *es,
                         command_state_t *cs,
-                        const tele_command_t *post_command);
+                        const tele_command_view_t *post_command);
 static void mod_ELIF_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_ELSE_func(scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command);
+                          const tele_command_view_t *post_command);
 static void mod_L_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command);
+                       const tele_command_view_t *post_command);
 
 static void op_SCENE_get(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
@@ -43,58 +44,56 @@ const tele_op_t op_SCENE =
     MAKE_GET_SET_OP(SCENE, op_SCENE_get, op_SCENE_set, 0, true);
 
 
-static void mod_PROB_func(scene_state_t *ss, exec_state_t *es,
+static void mod_PROB_func(scene_state_t *NOTUSED(ss), exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
 
-    if (rand() % 101 < a) { process_command(ss, es, post_command); }
+    if (rand() % 101 < a) { es_run_post_command(es, post_command); }
 }
 
-static void mod_IF_func(scene_state_t *ss, exec_state_t *es,
+static void mod_IF_func(scene_state_t *NOTUSED(ss), exec_state_t *es,
                         command_state_t *cs,
-                        const tele_command_t *post_command) {
+                        const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
 
     es->if_else_condition = false;
     if (a) {
         es->if_else_condition = true;
-        process_command(ss, es, post_command);
+        es_run_post_command(es, post_command);
     }
 }
 
-static void mod_ELIF_func(scene_state_t *ss, exec_state_t *es,
+static void mod_ELIF_func(scene_state_t *NOTUSED(ss), exec_state_t *es,
                           command_state_t *cs,
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
 
     if (!es->if_else_condition) {
         if (a) {
             es->if_else_condition = true;
-            process_command(ss, es, post_command);
+            es_run_post_command(es, post_command);
         }
     }
 }
 
-static void mod_ELSE_func(scene_state_t *ss, exec_state_t *es,
+static void mod_ELSE_func(scene_state_t *NOTUSED(ss), exec_state_t *es,
                           command_state_t *NOTUSED(cs),
-                          const tele_command_t *post_command) {
+                          const tele_command_view_t *post_command) {
     if (!es->if_else_condition) {
         es->if_else_condition = true;
-        process_command(ss, es, post_command);
+        es_run_post_command(es, post_command);
     }
 }
 
 static void mod_L_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command) {
+                       const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
-    int16_t loop_size = a < b ? b - a : a - b;
 
-    for (int16_t i = 0; i <= loop_size; i++) {
-        ss->variables.i = a < b ? a + i : a - i;
-        process_command(ss, es, post_command);
-    }
+    // the executor sets I for the rest of the loop
+    ss->variables.i = a;
+    es_loop_post_command(es, post_command, a, b);
 }
 
 static void op_SCENE_get(const void *NOTUSED(data), scene_state_t *ss,
@@ -107,6 +106,8 @@ static void op_SCENE_set(const void *NOTUSED(data), scene_state_t *ss,
     int16_t scene = cs_pop(cs);
     ss->variables.scene = scene;
     tele_scene(scene);
+    // the new scene hasn't subscribed to anything yet
+    ii_cache_clear();
 }
 
 static void op_SCRIPT_get(const void *NOTUSED(data), scene_state_t *ss,
@@ -114,6 +115,7 @@ static void op_SCRIPT_get(const void *NOTUSED(data), scene_state_t *ss,
     uint16_t a = cs_pop(cs) - 1;
     if (a >= SCRIPT_COUNT || a == INIT_SCRIPT || a == METRO_SCRIPT) return;
 
+    // compiled commands use I_SCRIPT instead, which doesn't need to recurse
     run_script_with_exec_state(ss, es, a);
 }
 
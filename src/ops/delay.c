@@ -6,7 +6,7 @@
 
 static void mod_DEL_func(scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs,
-                         const tele_command_t *post_command);
+                         const tele_command_view_t *post_command);
 
 static void op_DEL_CLR_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
@@ -17,21 +17,13 @@ const tele_op_t op_DEL_CLR = MAKE_GET_OP(DEL.CLR, op_DEL_CLR_get, 0, false);
 
 static void mod_DEL_func(scene_state_t *ss, exec_state_t *NOTUSED(es),
                          command_state_t *cs,
-                         const tele_command_t *post_command) {
-    int16_t i = 0;
+                         const tele_command_view_t *post_command) {
     int16_t a = cs_pop(cs);
 
     if (a < 1) a = 1;
 
-    while (ss->delay.time[i] != 0 && i != DELAY_SIZE) i++;
-
-    if (i < DELAY_SIZE) {
-        ss->delay.count++;
-        tele_has_delays(ss->delay.count > 0);
-        ss->delay.time[i] = a;
-
-        copy_command(&ss->delay.commands[i], post_command);
-    }
+    if (ss_add_delay(ss, (uint32_t)a * TICKS_PER_MS, post_command))
+        tele_has_delays(true);
 }
 
 static void op_DEL_CLR_get(const void *NOTUSED(data), scene_state_t *ss,
@@ -2,6 +2,7 @@
 
 #include "helpers.h"
 #include "ii.h"
+#include "ii_bus.h"
 #include "teletype_io.h"
 
 static void op_CV_get(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -44,6 +45,14 @@ static void op_MUTE_set(const void *data, scene_state_t *ss, exec_state_t *es,
                         command_state_t *cs);
 static void op_STATE_get(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
+static void op_II_FLUSH_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_II_POLL_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_II_POLL_set(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_II_REFRESH_get(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
 
 
 // clang-format off
@@ -62,6 +71,8 @@ const tele_op_t op_TR_P     = MAKE_ALIAS_OP  (TR.P    , op_TR_PULSE_get, NULL, 1
 const tele_op_t op_CV_SET   = MAKE_GET_OP    (CV.SET  , op_CV_SET_get  , 2, false);
 const tele_op_t op_MUTE     = MAKE_GET_SET_OP(MUTE    , op_MUTE_get    , op_MUTE_set   , 1, true);
 const tele_op_t op_STATE    = MAKE_GET_OP    (STATE   , op_STATE_get   , 1, true );
+const tele_op_t op_II_FLUSH = MAKE_GET_OP    (II.FLUSH, op_II_FLUSH_get, 0, false);
+const tele_op_t op_II_POLL  = MAKE_GET_SET_OP(II.POLL , op_II_POLL_get , op_II_POLL_set, 0, true);
 // clang-format on
 
 static void op_CV_get(const void *NOTUSED(data), scene_state_t *ss,
@@ -73,12 +84,10 @@ static void op_CV_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 4)
         cs_push(cs, ss->variables.cv[a]);
     else if (a < 20) {
-        uint8_t d[] = { II_ANSIBLE_CV | II_GET, a & 0x3 };
+        uint8_t request[] = { II_ANSIBLE_CV | II_GET, a & 0x3 };
+        uint8_t d[] = { 0, 0 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
-        d[0] = 0;
-        d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_read(addr, request, 2, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -101,7 +110,7 @@ static void op_CV_set(const void *NOTUSED(data), scene_state_t *ss,
         uint8_t d[] = { II_ANSIBLE_CV, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
 
-        tele_ii_tx(addr, d, 4);
+        ii_tx_set(addr, d, 4);
     }
 }
 
@@ -116,10 +125,10 @@ static void op_CV_SLEW_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_SLEW | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -141,7 +150,7 @@ static void op_CV_SLEW_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_SLEW, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx_set(addr, d, 4);
     }
 }
 
@@ -156,10 +165,10 @@ static void op_CV_OFF_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_OFF | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -182,7 +191,7 @@ static void op_CV_OFF_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_OFF, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx_set(addr, d, 4);
     }
 }
 
@@ -207,9 +216,9 @@ static void op_TR_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
         d[0] = 0;
-        tele_ii_rx(addr, d, 1);
+        ii_rx(addr, d, 1);
         cs_push(cs, d[0]);
     }
     else
@@ -230,7 +239,7 @@ static void op_TR_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR, a & 0x3, b };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 3);
+        ii_tx_set(addr, d, 3);
     }
 }
 
@@ -245,9 +254,9 @@ static void op_TR_POL_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_POL | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
         d[0] = 0;
-        tele_ii_rx(addr, d, 1);
+        ii_rx(addr, d, 1);
         cs_push(cs, d[0]);
     }
     else
@@ -267,7 +276,7 @@ static void op_TR_POL_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_POL, a & 0x3, b > 0 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 3);
+        ii_tx_set(addr, d, 3);
     }
 }
 
@@ -282,10 +291,10 @@ static void op_TR_TIME_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_TIME | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -306,7 +315,7 @@ static void op_TR_TIME_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_TIME, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx_set(addr, d, 4);
     }
 }
 
@@ -326,7 +335,7 @@ static void op_TR_TOG_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_TOG, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
     }
 }
 
@@ -340,13 +349,13 @@ static void op_TR_PULSE_get(const void *NOTUSED(data), scene_state_t *ss,
         int16_t time = ss->variables.tr_time[a];  // pulse time
         if (time <= 0) return;  // if time <= 0 don't do anything
         ss->variables.tr[a] = ss->variables.tr_pol[a];
-        ss->tr_pulse_timer[a] = time;  // set time
+        ss->tr_pulse_timer[a] = (int32_t)time * TICKS_PER_MS;  // set time
         tele_tr(a, ss->variables.tr[a]);
     }
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_PULSE, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
     }
 }
 
@@ -370,7 +379,7 @@ static void op_CV_SET_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_SET, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx_set(addr, d, 4);
     }
 }
 
@@ -401,11 +410,43 @@ static void op_STATE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
     else if (a < 24) {
         uint8_t d[] = { II_ANSIBLE_INPUT | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 8) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(addr, d, 2);
         d[0] = 0;
-        tele_ii_rx(addr, d, 1);
+        ii_rx(addr, d, 1);
         cs_push(cs, d[0]);
     }
     else
         cs_push(cs, 0);
 }
+
+// the writes queued so far are sent now, rather than when the script ends
+static void op_II_FLUSH_get(const void *NOTUSED(data),
+                            scene_state_t *NOTUSED(ss),
+                            exec_state_t *NOTUSED(es),
+                            command_state_t *NOTUSED(cs)) {
+    ii_tx_flush();
+}
+
+static void op_II_POLL_get(const void *NOTUSED(data),
+                           scene_state_t *NOTUSED(ss),
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ii_get_poll_ms());
+}
+
+static void op_II_POLL_set(const void *NOTUSED(data),
+                           scene_state_t *NOTUSED(ss),
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t ms = cs_pop(cs);
+    ii_set_poll_ms(ms < 0 ? 0 : ms);
+}
+
+const tele_op_t op_II_REFRESH =
+    MAKE_GET_OP(II.REFRESH, op_II_REFRESH_get, 0, false);
+
+// the cached remote inputs are read now, rather than in the background
+static void op_II_REFRESH_get(const void *NOTUSED(data),
+                              scene_state_t *NOTUSED(ss),
+                              exec_state_t *NOTUSED(es),
+                              command_state_t *NOTUSED(cs)) {
+    ii_refresh();
+}
@@ -18,5 +18,8 @@ extern const tele_op_t op_TR_P;
 extern const tele_op_t op_CV_SET;
 extern const tele_op_t op_MUTE;
 extern const tele_op_t op_STATE;
+extern const tele_op_t op_II_FLUSH;
+extern const tele_op_t op_II_POLL;
+extern const tele_op_t op_II_REFRESH;
 
 #endif
@@ -0,0 +1,296 @@
+// clang-format off
+
+#include "ii.h"
+#include "ops/ansible.h"
+#include "ops/justfriends.h"
+#include "ops/telex.h"
+
+// This file has been autogenerated by 'utils/ii_ops.py' from the ii entries in
+// 'docs/ops/*.toml'
+
+static const tele_ii_op_t ii_ops[] = {
+    { II_KR_ADDR, II_KR_PRESET, II_OP_BYTES, 0, 0x00, 1 },  // KR.PRE
+    { II_KR_ADDR, II_KR_PERIOD, II_OP_BYTES, 0, 0x01, 2 },  // KR.PERIOD
+    { II_KR_ADDR, II_KR_PATTERN, II_OP_BYTES, 0, 0x00, 1 },  // KR.PAT
+    { II_KR_ADDR, II_KR_SCALE, II_OP_BYTES, 0, 0x00, 1 },  // KR.SCALE
+    { II_KR_ADDR, II_KR_POS, II_OP_BYTES, 2, 0x00, 1 },  // KR.POS
+    { II_KR_ADDR, II_KR_LOOP_ST, II_OP_BYTES, 2, 0x00, 1 },  // KR.L.ST
+    { II_KR_ADDR, II_KR_LOOP_LEN, II_OP_BYTES, 2, 0x00, 1 },  // KR.L.LEN
+    { II_KR_ADDR, II_KR_RESET, II_OP_BYTES, 2, 0x00, 0 },  // KR.RES
+    { II_MP_ADDR, II_MP_PRESET, II_OP_BYTES, 0, 0x00, 1 },  // ME.PRE
+    { II_MP_ADDR, II_MP_SCALE, II_OP_BYTES, 0, 0x00, 1 },  // ME.SCALE
+    { II_MP_ADDR, II_MP_PERIOD, II_OP_BYTES, 0, 0x01, 2 },  // ME.PERIOD
+    { II_MP_ADDR, II_MP_STOP, II_OP_BYTES, 1, 0x00, 0 },  // ME.STOP
+    { II_MP_ADDR, II_MP_RESET, II_OP_BYTES, 1, 0x00, 0 },  // ME.RES
+    { II_LV_ADDR, II_LV_PRESET, II_OP_BYTES, 0, 0x00, 1 },  // LV.PRE
+    { II_LV_ADDR, II_LV_RESET, II_OP_BYTES, 1, 0x00, 0 },  // LV.RES
+    { II_LV_ADDR, II_LV_POS, II_OP_BYTES, 0, 0x00, 1 },  // LV.POS
+    { II_LV_ADDR, II_LV_L_ST, II_OP_BYTES, 0, 0x00, 1 },  // LV.L.ST
+    { II_LV_ADDR, II_LV_L_LEN, II_OP_BYTES, 0, 0x00, 1 },  // LV.L.LEN
+    { II_LV_ADDR, II_LV_L_DIR, II_OP_BYTES, 0, 0x00, 1 },  // LV.L.DIR
+    { II_CY_ADDR, II_CY_PRESET, II_OP_BYTES, 0, 0x00, 1 },  // CY.PRE
+    { II_CY_ADDR, II_CY_RESET, II_OP_BYTES, 1, 0x00, 0 },  // CY.RES
+    { II_CY_ADDR, II_CY_POS, II_OP_BYTES, 1, 0x00, 1 },  // CY.POS
+    { II_CY_ADDR, II_CY_REV, II_OP_BYTES, 1, 0x00, 0 },  // CY.REV
+    { II_MID_ADDR, II_MID_SLEW, II_OP_BYTES, 1, 0x01, 0 },  // MID.SLEW
+    { II_MID_ADDR, II_MID_SHIFT, II_OP_BYTES, 1, 0x01, 0 },  // MID.SHIFT
+    { II_ARP_ADDR, II_ARP_HOLD, II_OP_BYTES, 1, 0x00, 0 },  // ARP.HLD
+    { II_ARP_ADDR, II_ARP_STYLE, II_OP_BYTES, 1, 0x00, 0 },  // ARP.STY
+    { II_ARP_ADDR, II_ARP_GATE, II_OP_BYTES, 2, 0x00, 0 },  // ARP.GT
+    { II_ARP_ADDR, II_ARP_SLEW, II_OP_BYTES, 2, 0x02, 0 },  // ARP.SLEW
+    { II_ARP_ADDR, II_ARP_RPT, II_OP_BYTES, 3, 0x04, 0 },  // ARP.RPT
+    { II_ARP_ADDR, II_ARP_DIV, II_OP_BYTES, 2, 0x00, 0 },  // ARP.DIV
+    { II_ARP_ADDR, II_ARP_FILL, II_OP_BYTES, 2, 0x00, 0 },  // ARP.FIL
+    { II_ARP_ADDR, II_ARP_ROT, II_OP_BYTES, 2, 0x02, 0 },  // ARP.ROT
+    { II_ARP_ADDR, II_ARP_ER, II_OP_BYTES, 4, 0x08, 0 },  // ARP.ER
+    { II_ARP_ADDR, II_ARP_RESET, II_OP_BYTES, 1, 0x00, 0 },  // ARP.RES
+    { II_ARP_ADDR, II_ARP_SHIFT, II_OP_BYTES, 2, 0x02, 0 },  // ARP.SHIFT
+    { JF_ADDR, JF_TR, II_OP_BYTES, 2, 0x00, 0 },  // JF.TR
+    { JF_ADDR, JF_RMODE, II_OP_BYTES, 1, 0x00, 0 },  // JF.RMODE
+    { JF_ADDR, JF_RUN, II_OP_BYTES, 1, 0x01, 0 },  // JF.RUN
+    { JF_ADDR, JF_SHIFT, II_OP_BYTES, 1, 0x01, 0 },  // JF.SHIFT
+    { JF_ADDR, JF_VTR, II_OP_BYTES, 2, 0x02, 0 },  // JF.VTR
+    { JF_ADDR, JF_MODE, II_OP_BYTES, 1, 0x00, 0 },  // JF.MODE
+    { JF_ADDR, JF_TICK, II_OP_BYTES, 1, 0x00, 0 },  // JF.TICK
+    { JF_ADDR, JF_VOX, II_OP_BYTES, 3, 0x06, 0 },  // JF.VOX
+    { JF_ADDR, JF_NOTE, II_OP_BYTES, 2, 0x03, 0 },  // JF.NOTE
+    { JF_ADDR, JF_GOD, II_OP_BYTES, 1, 0x00, 0 },  // JF.GOD
+    { JF_ADDR, JF_TUNE, II_OP_BYTES, 3, 0x00, 0 },  // JF.TUNE
+    { JF_ADDR, JF_QT, II_OP_BYTES, 1, 0x00, 0 },  // JF.QT
+    { TI, TI_PARAM, II_OP_TX_INPUT, 1, 0, 0 },  // TI.PARAM
+    { TI, TI_PARAM_QT, II_OP_TX_INPUT, 1, 0, 0 },  // TI.PARAM.QT
+    { TI, TI_PARAM_N, II_OP_TX_INPUT, 1, 0, 0 },  // TI.PARAM.N
+    { TI, TI_PARAM_SCALE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TI.PARAM.SCALE
+    { TI, TI_IN, II_OP_TX_INPUT, 1, 0, 0 },  // TI.IN
+    { TI, TI_IN_QT, II_OP_TX_INPUT, 1, 0, 0 },  // TI.IN.QT
+    { TI, TI_IN_N, II_OP_TX_INPUT, 1, 0, 0 },  // TI.IN.N
+    { TI, TI_IN_SCALE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TI.IN.SCALE
+    { TI, TI_PARAM_CALIB, II_OP_TX_OUTPUT, 2, 0, 0 },  // TI.PARAM.CALIB
+    { TI, TI_IN_CALIB, II_OP_TX_OUTPUT, 2, 0, 0 },  // TI.IN.CALIB
+    { TI, TI_STORE, II_OP_TX_DEVICE, 1, 0, 0 },  // TI.STORE
+    { TI, TI_RESET, II_OP_TX_DEVICE, 1, 0, 0 },  // TI.RESET
+    { TO, TO_TR, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR
+    { TO, TO_TR_TOG, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.TR.TOG
+    { TO, TO_TR_PULSE, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.TR.PULSE
+    { TO, TO_TR_PULSE_DIV, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.PULSE.DIV
+    { TO, TO_TR_PULSE_MUTE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.PULSE.MUTE
+    { TO, TO_TR_TIME, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.TIME
+    { TO, TO_TR_TIME_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.TIME.S
+    { TO, TO_TR_TIME_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.TIME.M
+    { TO, TO_TR_WIDTH, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.WIDTH
+    { TO, TO_TR_POL, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.POL
+    { TO, TO_TR_M_ACT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M.ACT
+    { TO, TO_TR_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M
+    { TO, TO_TR_M_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M.S
+    { TO, TO_TR_M_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M.M
+    { TO, TO_TR_M_BPM, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M.BPM
+    { TO, TO_TR_M_COUNT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M.COUNT
+    { TO, TO_TR_M_MUL, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.TR.M.MUL
+    { TO, TO_TR_M_SYNC, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.TR.M.SYNC
+    { TO, TO_M_ACT, II_OP_TX_DEVICE, 2, 0, 0 },  // TO.M.ACT
+    { TO, TO_M, II_OP_TX_DEVICE, 2, 0, 0 },  // TO.M
+    { TO, TO_M_S, II_OP_TX_DEVICE, 2, 0, 0 },  // TO.M.S
+    { TO, TO_M_M, II_OP_TX_DEVICE, 2, 0, 0 },  // TO.M.M
+    { TO, TO_M_BPM, II_OP_TX_DEVICE, 2, 0, 0 },  // TO.M.BPM
+    { TO, TO_M_COUNT, II_OP_TX_DEVICE, 2, 0, 0 },  // TO.M.COUNT
+    { TO, TO_M_SYNC, II_OP_TX_DEVICE, 1, 0, 0 },  // TO.M.SYNC
+    { TO, TO_CV, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV
+    { TO, TO_CV_SLEW, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.SLEW
+    { TO, TO_CV_SLEW_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.SLEW.S
+    { TO, TO_CV_SLEW_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.SLEW.M
+    { TO, TO_CV_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.SET
+    { TO, TO_CV_OFF, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.OFF
+    { TO, TO_CV_QT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.QT
+    { TO, TO_CV_QT_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.QT.SET
+    { TO, TO_CV_N, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.N
+    { TO, TO_CV_N_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.N.SET
+    { TO, TO_CV_SCALE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.SCALE
+    { TO, TO_CV_LOG, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.CV.LOG
+    { TO, TO_OSC, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC
+    { TO, TO_OSC_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.SET
+    { TO, TO_OSC_QT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.QT
+    { TO, TO_OSC_QT_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.QT.SET
+    { TO, TO_OSC_N, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.N
+    { TO, TO_OSC_N_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.N.SET
+    { TO, TO_OSC_FQ, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.FQ
+    { TO, TO_OSC_FQ_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.FQ.SET
+    { TO, TO_OSC_LFO, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.LFO
+    { TO, TO_OSC_LFO_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.LFO.SET
+    { TO, TO_OSC_CYC, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CYC
+    { TO, TO_OSC_CYC_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CYC.SET
+    { TO, TO_OSC_CYC_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CYC.S
+    { TO, TO_OSC_CYC_S_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CYC.S.SET
+    { TO, TO_OSC_CYC_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CYC.M
+    { TO, TO_OSC_CYC_M_SET, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CYC.M.SET
+    { TO, TO_OSC_SCALE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.SCALE
+    { TO, TO_OSC_WAVE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.WAVE
+    { TO, TO_OSC_RECT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.RECT
+    { TO, TO_OSC_WIDTH, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.WIDTH
+    { TO, TO_OSC_SYNC, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.OSC.SYNC
+    { TO, TO_OSC_PHASE, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.PHASE
+    { TO, TO_OSC_SLEW, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.SLEW
+    { TO, TO_OSC_SLEW_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.SLEW.S
+    { TO, TO_OSC_SLEW_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.SLEW.M
+    { TO, TO_OSC_CTR, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.OSC.CTR
+    { TO, TO_ENV_ACT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.ACT
+    { TO, TO_ENV_TRIG, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.ENV.TRIG
+    { TO, TO_ENV_ATT, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.ATT
+    { TO, TO_ENV_ATT_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.ATT.S
+    { TO, TO_ENV_ATT_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.ATT.M
+    { TO, TO_ENV_DEC, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.DEC
+    { TO, TO_ENV_DEC_S, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.DEC.S
+    { TO, TO_ENV_DEC_M, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.DEC.M
+    { TO, TO_ENV_EOR, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.EOR
+    { TO, TO_ENV_EOC, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.EOC
+    { TO, TO_ENV_LOOP, II_OP_TX_OUTPUT, 2, 0, 0 },  // TO.ENV.LOOP
+    { TO, TO_TR_INIT, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.TR.INIT
+    { TO, TO_CV_INIT, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.CV.INIT
+    { TO, TO_INIT, II_OP_TX_DEVICE, 1, 0, 0 },  // TO.INIT
+    { TO, TO_KILL, II_OP_TX_OUTPUT, 1, 0, 0 },  // TO.KILL
+};
+
+const tele_op_t op_KR_PRE = MAKE_II_GET_SET_OP(KR.PRE, &ii_ops[0], 0);
+const tele_op_t op_KR_PERIOD = MAKE_II_GET_SET_OP(KR.PERIOD, &ii_ops[1], 0);
+const tele_op_t op_KR_PAT = MAKE_II_GET_SET_OP(KR.PAT, &ii_ops[2], 0);
+const tele_op_t op_KR_SCALE = MAKE_II_GET_SET_OP(KR.SCALE, &ii_ops[3], 0);
+const tele_op_t op_KR_POS = MAKE_II_GET_SET_OP(KR.POS, &ii_ops[4], 2);
+const tele_op_t op_KR_L_ST = MAKE_II_GET_SET_OP(KR.L.ST, &ii_ops[5], 2);
+const tele_op_t op_KR_L_LEN = MAKE_II_GET_SET_OP(KR.L.LEN, &ii_ops[6], 2);
+const tele_op_t op_KR_RES = MAKE_II_OP(KR.RES, &ii_ops[7], 2, false);
+const tele_op_t op_ME_PRE = MAKE_II_GET_SET_OP(ME.PRE, &ii_ops[8], 0);
+const tele_op_t op_ME_SCALE = MAKE_II_GET_SET_OP(ME.SCALE, &ii_ops[9], 0);
+const tele_op_t op_ME_PERIOD = MAKE_II_GET_SET_OP(ME.PERIOD, &ii_ops[10], 0);
+const tele_op_t op_ME_STOP = MAKE_II_OP(ME.STOP, &ii_ops[11], 1, false);
+const tele_op_t op_ME_RES = MAKE_II_OP(ME.RES, &ii_ops[12], 1, false);
+const tele_op_t op_LV_PRE = MAKE_II_GET_SET_OP(LV.PRE, &ii_ops[13], 0);
+const tele_op_t op_LV_RES = MAKE_II_OP(LV.RES, &ii_ops[14], 1, false);
+const tele_op_t op_LV_POS = MAKE_II_GET_SET_OP(LV.POS, &ii_ops[15], 0);
+const tele_op_t op_LV_L_ST = MAKE_II_GET_SET_OP(LV.L.ST, &ii_ops[16], 0);
+const tele_op_t op_LV_L_LEN = MAKE_II_GET_SET_OP(LV.L.LEN, &ii_ops[17], 0);
+const tele_op_t op_LV_L_DIR = MAKE_II_GET_SET_OP(LV.L.DIR, &ii_ops[18], 0);
+const tele_op_t op_CY_PRE = MAKE_II_GET_SET_OP(CY.PRE, &ii_ops[19], 0);
+const tele_op_t op_CY_RES = MAKE_II_OP(CY.RES, &ii_ops[20], 1, false);
+const tele_op_t op_CY_POS = MAKE_II_GET_SET_OP(CY.POS, &ii_ops[21], 1);
+const tele_op_t op_CY_REV = MAKE_II_OP(CY.REV, &ii_ops[22], 1, false);
+const tele_op_t op_MID_SLEW = MAKE_II_OP(MID.SLEW, &ii_ops[23], 1, false);
+const tele_op_t op_MID_SHIFT = MAKE_II_OP(MID.SHIFT, &ii_ops[24], 1, false);
+const tele_op_t op_ARP_HLD = MAKE_II_OP(ARP.HLD, &ii_ops[25], 1, false);
+const tele_op_t op_ARP_STY = MAKE_II_OP(ARP.STY, &ii_ops[26], 1, false);
+const tele_op_t op_ARP_GT = MAKE_II_OP(ARP.GT, &ii_ops[27], 2, false);
+const tele_op_t op_ARP_SLEW = MAKE_II_OP(ARP.SLEW, &ii_ops[28], 2, false);
+const tele_op_t op_ARP_RPT = MAKE_II_OP(ARP.RPT, &ii_ops[29], 3, false);
+const tele_op_t op_ARP_DIV = MAKE_II_OP(ARP.DIV, &ii_ops[30], 2, false);
+const tele_op_t op_ARP_FIL = MAKE_II_OP(ARP.FIL, &ii_ops[31], 2, false);
+const tele_op_t op_ARP_ROT = MAKE_II_OP(ARP.ROT, &ii_ops[32], 2, false);
+const tele_op_t op_ARP_ER = MAKE_II_OP(ARP.ER, &ii_ops[33], 4, false);
+const tele_op_t op_ARP_RES = MAKE_II_OP(ARP.RES, &ii_ops[34], 1, false);
+const tele_op_t op_ARP_SHIFT = MAKE_II_OP(ARP.SHIFT, &ii_ops[35], 2, false);
+const tele_op_t op_JF_TR = MAKE_II_OP(JF.TR, &ii_ops[36], 2, false);
+const tele_op_t op_JF_RMODE = MAKE_II_OP(JF.RMODE, &ii_ops[37], 1, false);
+const tele_op_t op_JF_RUN = MAKE_II_OP(JF.RUN, &ii_ops[38], 1, false);
+const tele_op_t op_JF_SHIFT = MAKE_II_OP(JF.SHIFT, &ii_ops[39], 1, false);
+const tele_op_t op_JF_VTR = MAKE_II_OP(JF.VTR, &ii_ops[40], 2, false);
+const tele_op_t op_JF_MODE = MAKE_II_OP(JF.MODE, &ii_ops[41], 1, false);
+const tele_op_t op_JF_TICK = MAKE_II_OP(JF.TICK, &ii_ops[42], 1, false);
+const tele_op_t op_JF_VOX = MAKE_II_OP(JF.VOX, &ii_ops[43], 3, false);
+const tele_op_t op_JF_NOTE = MAKE_II_OP(JF.NOTE, &ii_ops[44], 2, false);
+const tele_op_t op_JF_GOD = MAKE_II_OP(JF.GOD, &ii_ops[45], 1, false);
+const tele_op_t op_JF_TUNE = MAKE_II_OP(JF.TUNE, &ii_ops[46], 3, false);
+const tele_op_t op_JF_QT = MAKE_II_OP(JF.QT, &ii_ops[47], 1, false);
+const tele_op_t op_TI_PARAM = MAKE_II_OP(TI.PARAM, &ii_ops[48], 1, true);
+const tele_op_t op_TI_PRM = MAKE_II_OP(TI.PRM, &ii_ops[48], 1, true);
+const tele_op_t op_TI_PARAM_QT = MAKE_II_OP(TI.PARAM.QT, &ii_ops[49], 1, true);
+const tele_op_t op_TI_PRM_QT = MAKE_II_OP(TI.PRM.QT, &ii_ops[49], 1, true);
+const tele_op_t op_TI_PARAM_N = MAKE_II_OP(TI.PARAM.N, &ii_ops[50], 1, true);
+const tele_op_t op_TI_PRM_N = MAKE_II_OP(TI.PRM.N, &ii_ops[50], 1, true);
+const tele_op_t op_TI_PARAM_SCALE = MAKE_II_OP(TI.PARAM.SCALE, &ii_ops[51], 2, false);
+const tele_op_t op_TI_PRM_SCALE = MAKE_II_OP(TI.PRM.SCALE, &ii_ops[51], 2, false);
+const tele_op_t op_TI_IN = MAKE_II_OP(TI.IN, &ii_ops[52], 1, true);
+const tele_op_t op_TI_IN_QT = MAKE_II_OP(TI.IN.QT, &ii_ops[53], 1, true);
+const tele_op_t op_TI_IN_N = MAKE_II_OP(TI.IN.N, &ii_ops[54], 1, true);
+const tele_op_t op_TI_IN_SCALE = MAKE_II_OP(TI.IN.SCALE, &ii_ops[55], 2, false);
+const tele_op_t op_TI_PARAM_CALIB = MAKE_II_OP(TI.PARAM.CALIB, &ii_ops[56], 2, false);
+const tele_op_t op_TI_IN_CALIB = MAKE_II_OP(TI.IN.CALIB, &ii_ops[57], 2, false);
+const tele_op_t op_TI_STORE = MAKE_II_OP(TI.STORE, &ii_ops[58], 1, false);
+const tele_op_t op_TI_RESET = MAKE_II_OP(TI.RESET, &ii_ops[59], 1, false);
+const tele_op_t op_TO_TR = MAKE_II_OP(TO.TR, &ii_ops[60], 2, false);
+const tele_op_t op_TO_TR_TOG = MAKE_II_OP(TO.TR.TOG, &ii_ops[61], 1, false);
+const tele_op_t op_TO_TR_PULSE = MAKE_II_OP(TO.TR.PULSE, &ii_ops[62], 1, false);
+const tele_op_t op_TO_TR_P = MAKE_II_OP(TO.TR.P, &ii_ops[62], 1, false);
+const tele_op_t op_TO_TR_PULSE_DIV = MAKE_II_OP(TO.TR.PULSE.DIV, &ii_ops[63], 2, false);
+const tele_op_t op_TO_TR_P_DIV = MAKE_II_OP(TO.TR.P.DIV, &ii_ops[63], 2, false);
+const tele_op_t op_TO_TR_PULSE_MUTE = MAKE_II_OP(TO.TR.PULSE.MUTE, &ii_ops[64], 2, false);
+const tele_op_t op_TO_TR_P_MUTE = MAKE_II_OP(TO.TR.P.MUTE, &ii_ops[64], 2, false);
+const tele_op_t op_TO_TR_TIME = MAKE_II_OP(TO.TR.TIME, &ii_ops[65], 2, false);
+const tele_op_t op_TO_TR_TIME_S = MAKE_II_OP(TO.TR.TIME.S, &ii_ops[66], 2, false);
+const tele_op_t op_TO_TR_TIME_M = MAKE_II_OP(TO.TR.TIME.M, &ii_ops[67], 2, false);
+const tele_op_t op_TO_TR_WIDTH = MAKE_II_OP(TO.TR.WIDTH, &ii_ops[68], 2, false);
+const tele_op_t op_TO_TR_POL = MAKE_II_OP(TO.TR.POL, &ii_ops[69], 2, false);
+const tele_op_t op_TO_TR_M_ACT = MAKE_II_OP(TO.TR.M.ACT, &ii_ops[70], 2, false);
+const tele_op_t op_TO_TR_M = MAKE_II_OP(TO.TR.M, &ii_ops[71], 2, false);
+const tele_op_t op_TO_TR_M_S = MAKE_II_OP(TO.TR.M.S, &ii_ops[72], 2, false);
+const tele_op_t op_TO_TR_M_M = MAKE_II_OP(TO.TR.M.M, &ii_ops[73], 2, false);
+const tele_op_t op_TO_TR_M_BPM = MAKE_II_OP(TO.TR.M.BPM, &ii_ops[74], 2, false);
+const tele_op_t op_TO_TR_M_COUNT = MAKE_II_OP(TO.TR.M.COUNT, &ii_ops[75], 2, false);
+const tele_op_t op_TO_TR_M_MUL = MAKE_II_OP(TO.TR.M.MUL, &ii_ops[76], 2, false);
+const tele_op_t op_TO_TR_M_SYNC = MAKE_II_OP(TO.TR.M.SYNC, &ii_ops[77], 1, false);
+const tele_op_t op_TO_M_ACT = MAKE_II_OP(TO.M.ACT, &ii_ops[78], 2, false);
+const tele_op_t op_TO_M = MAKE_II_OP(TO.M, &ii_ops[79], 2, false);
+const tele_op_t op_TO_M_S = MAKE_II_OP(TO.M.S, &ii_ops[80], 2, false);
+const tele_op_t op_TO_M_M = MAKE_II_OP(TO.M.M, &ii_ops[81], 2, false);
+const tele_op_t op_TO_M_BPM = MAKE_II_OP(TO.M.BPM, &ii_ops[82], 2, false);
+const tele_op_t op_TO_M_COUNT = MAKE_II_OP(TO.M.COUNT, &ii_ops[83], 2, false);
+const tele_op_t op_TO_M_SYNC = MAKE_II_OP(TO.M.SYNC, &ii_ops[84], 1, false);
+const tele_op_t op_TO_CV = MAKE_II_OP(TO.CV, &ii_ops[85], 2, false);
+const tele_op_t op_TO_CV_SLEW = MAKE_II_OP(TO.CV.SLEW, &ii_ops[86], 2, false);
+const tele_op_t op_TO_CV_SLEW_S = MAKE_II_OP(TO.CV.SLEW.S, &ii_ops[87], 2, false);
+const tele_op_t op_TO_CV_SLEW_M = MAKE_II_OP(TO.CV.SLEW.M, &ii_ops[88], 2, false);
+const tele_op_t op_TO_CV_SET = MAKE_II_OP(TO.CV.SET, &ii_ops[89], 2, false);
+const tele_op_t op_TO_CV_OFF = MAKE_II_OP(TO.CV.OFF, &ii_ops[90], 2, false);
+const tele_op_t op_TO_CV_QT = MAKE_II_OP(TO.CV.QT, &ii_ops[91], 2, false);
+const tele_op_t op_TO_CV_QT_SET = MAKE_II_OP(TO.CV.QT.SET, &ii_ops[92], 2, false);
+const tele_op_t op_TO_CV_N = MAKE_II_OP(TO.CV.N, &ii_ops[93], 2, false);
+const tele_op_t op_TO_CV_N_SET = MAKE_II_OP(TO.CV.N.SET, &ii_ops[94], 2, false);
+const tele_op_t op_TO_CV_SCALE = MAKE_II_OP(TO.CV.SCALE, &ii_ops[95], 2, false);
+const tele_op_t op_TO_CV_LOG = MAKE_II_OP(TO.CV.LOG, &ii_ops[96], 2, false);
+const tele_op_t op_TO_OSC = MAKE_II_OP(TO.OSC, &ii_ops[97], 2, false);
+const tele_op_t op_TO_OSC_SET = MAKE_II_OP(TO.OSC.SET, &ii_ops[98], 2, false);
+const tele_op_t op_TO_OSC_QT = MAKE_II_OP(TO.OSC.QT, &ii_ops[99], 2, false);
+const tele_op_t op_TO_OSC_QT_SET = MAKE_II_OP(TO.OSC.QT.SET, &ii_ops[100], 2, false);
+const tele_op_t op_TO_OSC_N = MAKE_II_OP(TO.OSC.N, &ii_ops[101], 2, false);
+const tele_op_t op_TO_OSC_N_SET = MAKE_II_OP(TO.OSC.N.SET, &ii_ops[102], 2, false);
+const tele_op_t op_TO_OSC_FQ = MAKE_II_OP(TO.OSC.FQ, &ii_ops[103], 2, false);
+const tele_op_t op_TO_OSC_FQ_SET = MAKE_II_OP(TO.OSC.FQ.SET, &ii_ops[104], 2, false);
+const tele_op_t op_TO_OSC_LFO = MAKE_II_OP(TO.OSC.LFO, &ii_ops[105], 2, false);
+const tele_op_t op_TO_OSC_LFO_SET = MAKE_II_OP(TO.OSC.LFO.SET, &ii_ops[106], 2, false);
+const tele_op_t op_TO_OSC_CYC = MAKE_II_OP(TO.OSC.CYC, &ii_ops[107], 2, false);
+const tele_op_t op_TO_OSC_CYC_SET = MAKE_II_OP(TO.OSC.CYC.SET, &ii_ops[108], 2, false);
+const tele_op_t op_TO_OSC_CYC_S = MAKE_II_OP(TO.OSC.CYC.S, &ii_ops[109], 2, false);
+const tele_op_t op_TO_OSC_CYC_S_SET = MAKE_II_OP(TO.OSC.CYC.S.SET, &ii_ops[110], 2, false);
+const tele_op_t op_TO_OSC_CYC_M = MAKE_II_OP(TO.OSC.CYC.M, &ii_ops[111], 2, false);
+const tele_op_t op_TO_OSC_CYC_M_SET = MAKE_II_OP(TO.OSC.CYC.M.SET, &ii_ops[112], 2, false);
+const tele_op_t op_TO_OSC_SCALE = MAKE_II_OP(TO.OSC.SCALE, &ii_ops[113], 2, false);
+const tele_op_t op_TO_OSC_WAVE = MAKE_II_OP(TO.OSC.WAVE, &ii_ops[114], 2, false);
+const tele_op_t op_TO_OSC_RECT = MAKE_II_OP(TO.OSC.RECT, &ii_ops[115], 2, false);
+const tele_op_t op_TO_OSC_WIDTH = MAKE_II_OP(TO.OSC.WIDTH, &ii_ops[116], 2, false);
+const tele_op_t op_TO_OSC_SYNC = MAKE_II_OP(TO.OSC.SYNC, &ii_ops[117], 1, false);
+const tele_op_t op_TO_OSC_PHASE = MAKE_II_OP(TO.OSC.PHASE, &ii_ops[118], 2, false);
+const tele_op_t op_TO_OSC_SLEW = MAKE_II_OP(TO.OSC.SLEW, &ii_ops[119], 2, false);
+const tele_op_t op_TO_OSC_SLEW_S = MAKE_II_OP(TO.OSC.SLEW.S, &ii_ops[120], 2, false);
+const tele_op_t op_TO_OSC_SLEW_M = MAKE_II_OP(TO.OSC.SLEW.M, &ii_ops[121], 2, false);
+const tele_op_t op_TO_OSC_CTR = MAKE_II_OP(TO.OSC.CTR, &ii_ops[122], 2, false);
+const tele_op_t op_TO_ENV_ACT = MAKE_II_OP(TO.ENV.ACT, &ii_ops[123], 2, false);
+const tele_op_t op_TO_ENV_TRIG = MAKE_II_OP(TO.ENV.TRIG, &ii_ops[124], 1, false);
+const tele_op_t op_TO_ENV_ATT = MAKE_II_OP(TO.ENV.ATT, &ii_ops[125], 2, false);
+const tele_op_t op_TO_ENV_ATT_S = MAKE_II_OP(TO.ENV.ATT.S, &ii_ops[126], 2, false);
+const tele_op_t op_TO_ENV_ATT_M = MAKE_II_OP(TO.ENV.ATT.M, &ii_ops[127], 2, false);
+const tele_op_t op_TO_ENV_DEC = MAKE_II_OP(TO.ENV.DEC, &ii_ops[128], 2, false);
+const tele_op_t op_TO_ENV_DEC_S = MAKE_II_OP(TO.ENV.DEC.S, &ii_ops[129], 2, false);
+const tele_op_t op_TO_ENV_DEC_M = MAKE_II_OP(TO.ENV.DEC.M, &ii_ops[130], 2, false);
+const tele_op_t op_TO_ENV_EOR = MAKE_II_OP(TO.ENV.EOR, &ii_ops[131], 2, false);
+const tele_op_t op_TO_ENV_EOC = MAKE_II_OP(TO.ENV.EOC, &ii_ops[132], 2, false);
+const tele_op_t op_TO_ENV_LOOP = MAKE_II_OP(TO.ENV.LOOP, &ii_ops[133], 2, false);
+const tele_op_t op_TO_TR_INIT = MAKE_II_OP(TO.TR.INIT, &ii_ops[134], 1, false);
+const tele_op_t op_TO_CV_INIT = MAKE_II_OP(TO.CV.INIT, &ii_ops[135], 1, false);
+const tele_op_t op_TO_INIT = MAKE_II_OP(TO.INIT, &ii_ops[136], 1, false);
+const tele_op_t op_TO_KILL = MAKE_II_OP(TO.KILL, &ii_ops[137], 1, false);
@@ -77,75 +77,81 @@ static void op_ER_get(const void *data, scene_state_t *ss, exec_state_t *es,
 
 
 // clang-format off
-const tele_op_t op_ADD   = MAKE_GET_OP(ADD     , op_ADD_get     , 2, true);
-const tele_op_t op_SUB   = MAKE_GET_OP(SUB     , op_SUB_get     , 2, true);
-const tele_op_t op_MUL   = MAKE_GET_OP(MUL     , op_MUL_get     , 2, true);
-const tele_op_t op_DIV   = MAKE_GET_OP(DIV     , op_DIV_get     , 2, true);
-const tele_op_t op_MOD   = MAKE_GET_OP(MOD     , op_MOD_get     , 2, true);
-const tele_op_t op_RAND  = MAKE_GET_OP(RAND    , op_RAND_get    , 1, true);
-const tele_op_t op_RRAND = MAKE_GET_OP(RRAND   , op_RRAND_get   , 2, true);
-const tele_op_t op_TOSS  = MAKE_GET_OP(TOSS    , op_TOSS_get    , 0, true);
-const tele_op_t op_MIN   = MAKE_GET_OP(MIN     , op_MIN_get     , 2, true);
-const tele_op_t op_MAX   = MAKE_GET_OP(MAX     , op_MAX_get     , 2, true);
-const tele_op_t op_LIM   = MAKE_GET_OP(LIM     , op_LIM_get     , 3, true);
-const tele_op_t op_WRAP  = MAKE_GET_OP(WRAP    , op_WRAP_get    , 3, true);
-const tele_op_t op_QT    = MAKE_GET_OP(QT      , op_QT_get      , 2, true);
-const tele_op_t op_AVG   = MAKE_GET_OP(AVG     , op_AVG_get     , 2, true);
-const tele_op_t op_EQ    = MAKE_GET_OP(EQ      , op_EQ_get      , 2, true);
-const tele_op_t op_NE    = MAKE_GET_OP(NE      , op_NE_get      , 2, true);
-const tele_op_t op_LT    = MAKE_GET_OP(LT      , op_LT_get      , 2, true);
-const tele_op_t op_GT    = MAKE_GET_OP(GT      , op_GT_get      , 2, true);
-const tele_op_t op_LTE   = MAKE_GET_OP(LTE     , op_LTE_get     , 2, true);
-const tele_op_t op_GTE   = MAKE_GET_OP(GTE     , op_GTE_get     , 2, true);
-const tele_op_t op_NZ    = MAKE_GET_OP(NZ      , op_NZ_get      , 1, true);
-const tele_op_t op_EZ    = MAKE_GET_OP(EZ      , op_EZ_get      , 1, true);
-const tele_op_t op_RSH   = MAKE_GET_OP(RSH     , op_RSH_get     , 2, true);
-const tele_op_t op_LSH   = MAKE_GET_OP(LSH     , op_LSH_get     , 2, true);
-const tele_op_t op_EXP   = MAKE_GET_OP(EXP     , op_EXP_get     , 1, true);
-const tele_op_t op_ABS   = MAKE_GET_OP(ABS     , op_ABS_get     , 1, true);
-const tele_op_t op_AND   = MAKE_GET_OP(AND     , op_AND_get     , 2, true);
-const tele_op_t op_OR    = MAKE_GET_OP(OR      , op_OR_get      , 2, true);
-const tele_op_t op_JI    = MAKE_GET_OP(JI      , op_JI_get      , 2, true);
-const tele_op_t op_SCALE = MAKE_GET_OP(SCALE   , op_SCALE_get   , 5, true);
-const tele_op_t op_N     = MAKE_GET_OP(N       , op_N_get       , 1, true);
-const tele_op_t op_V     = MAKE_GET_OP(V       , op_V_get       , 1, true);
-const tele_op_t op_VV    = MAKE_GET_OP(VV      , op_VV_get      , 1, true);
-const tele_op_t op_ER    = MAKE_GET_OP(ER      , op_ER_get      , 3, true);
-
-const tele_op_t op_XOR   = MAKE_ALIAS_OP(XOR, op_NE_get, NULL, 2, true);
-
-const tele_op_t op_SYM_PLUS               = MAKE_ALIAS_OP(+ , op_ADD_get, NULL, 2, true);
-const tele_op_t op_SYM_DASH               = MAKE_ALIAS_OP(- , op_SUB_get, NULL, 2, true);
-const tele_op_t op_SYM_STAR               = MAKE_ALIAS_OP(* , op_MUL_get, NULL, 2, true);
-const tele_op_t op_SYM_FORWARD_SLASH      = MAKE_ALIAS_OP(/ , op_DIV_get, NULL, 2, true);
-const tele_op_t op_SYM_PERCENTAGE         = MAKE_ALIAS_OP(% , op_MOD_get, NULL, 2, true);
-const tele_op_t op_SYM_EQUAL_x2           = MAKE_ALIAS_OP(==, op_EQ_get , NULL, 2, true);
-const tele_op_t op_SYM_EXCLAMATION_EQUAL  = MAKE_ALIAS_OP(!=, op_NE_get , NULL, 2, true);
-const tele_op_t op_SYM_LEFT_ANGLED        = MAKE_ALIAS_OP(< , op_LT_get , NULL, 2, true);
-const tele_op_t op_SYM_RIGHT_ANGLED       = MAKE_ALIAS_OP(> , op_GT_get , NULL, 2, true);
-const tele_op_t op_SYM_LEFT_ANGLED_EQUAL  = MAKE_ALIAS_OP(<=, op_LTE_get, NULL, 2, true);
-const tele_op_t op_SYM_RIGHT_ANGLED_EQUAL = MAKE_ALIAS_OP(>=, op_GTE_get, NULL, 2, true);
-const tele_op_t op_SYM_EXCLAMATION        = MAKE_ALIAS_OP(! , op_EZ_get , NULL, 1, true);
-const tele_op_t op_SYM_LEFT_ANGLED_x2     = MAKE_ALIAS_OP(<<, op_LSH_get, NULL, 2, true);
-const tele_op_t op_SYM_RIGHT_ANGLED_x2    = MAKE_ALIAS_OP(>>, op_RSH_get, NULL, 2, true);
-const tele_op_t op_SYM_AMPERSAND_x2       = MAKE_ALIAS_OP(&&, op_AND_get, NULL, 2, true);
-const tele_op_t op_SYM_PIPE_x2            = MAKE_ALIAS_OP(||, op_OR_get , NULL, 2, true);
+const tele_op_t op_ADD   = MAKE_PURE_OP(ADD     , op_ADD_get     , 2, true);
+const tele_op_t op_SUB   = MAKE_PURE_OP(SUB     , op_SUB_get     , 2, true);
+const tele_op_t op_MUL   = MAKE_PURE_OP(MUL     , op_MUL_get     , 2, true);
+const tele_op_t op_DIV   = MAKE_PURE_OP(DIV     , op_DIV_get     , 2, true);
+const tele_op_t op_MOD   = MAKE_PURE_OP(MOD     , op_MOD_get     , 2, true);
+const tele_op_t op_RAND  = MAKE_GET_OP(RAND     , op_RAND_get     , 1, true);
+const tele_op_t op_RRAND = MAKE_GET_OP(RRAND    , op_RRAND_get    , 2, true);
+const tele_op_t op_TOSS  = MAKE_GET_OP(TOSS     , op_TOSS_get     , 0, true);
+const tele_op_t op_MIN   = MAKE_PURE_OP(MIN     , op_MIN_get     , 2, true);
+const tele_op_t op_MAX   = MAKE_PURE_OP(MAX     , op_MAX_get     , 2, true);
+const tele_op_t op_LIM   = MAKE_PURE_OP(LIM     , op_LIM_get     , 3, true);
+const tele_op_t op_WRAP  = MAKE_PURE_OP(WRAP    , op_WRAP_get    , 3, true);
+const tele_op_t op_QT    = MAKE_PURE_OP(QT      , op_QT_get      , 2, true);
+const tele_op_t op_AVG   = MAKE_PURE_OP(AVG     , op_AVG_get     , 2, true);
+const tele_op_t op_EQ    = MAKE_PURE_OP(EQ      , op_EQ_get      , 2, true);
+const tele_op_t op_NE    = MAKE_PURE_OP(NE      , op_NE_get      , 2, true);
+const tele_op_t op_LT    = MAKE_PURE_OP(LT      , op_LT_get      , 2, true);
+const tele_op_t op_GT    = MAKE_PURE_OP(GT      , op_GT_get      , 2, true);
+const tele_op_t op_LTE   = MAKE_PURE_OP(LTE     , op_LTE_get     , 2, true);
+const tele_op_t op_GTE   = MAKE_PURE_OP(GTE     , op_GTE_get     , 2, true);
+const tele_op_t op_NZ    = MAKE_PURE_OP(NZ      , op_NZ_get      , 1, true);
+const tele_op_t op_EZ    = MAKE_PURE_OP(EZ      , op_EZ_get      , 1, true);
+const tele_op_t op_RSH   = MAKE_PURE_OP(RSH     , op_RSH_get     , 2, true);
+const tele_op_t op_LSH   = MAKE_PURE_OP(LSH     , op_LSH_get     , 2, true);
+const tele_op_t op_EXP   = MAKE_PURE_OP(EXP     , op_EXP_get     , 1, true);
+const tele_op_t op_ABS   = MAKE_PURE_OP(ABS     , op_ABS_get     , 1, true);
+const tele_op_t op_AND   = MAKE_PURE_OP(AND     , op_AND_get     , 2, true);
+const tele_op_t op_OR    = MAKE_PURE_OP(OR      , op_OR_get      , 2, true);
+const tele_op_t op_JI    = MAKE_PURE_OP(JI      , op_JI_get      , 2, true);
+const tele_op_t op_SCALE = MAKE_PURE_OP(SCALE   , op_SCALE_get   , 5, true);
+const tele_op_t op_N     = MAKE_PURE_OP(N       , op_N_get       , 1, true);
+const tele_op_t op_V     = MAKE_PURE_OP(V       , op_V_get       , 1, true);
+const tele_op_t op_VV    = MAKE_PURE_OP(VV      , op_VV_get      , 1, true);
+const tele_op_t op_ER    = MAKE_PURE_OP(ER      , op_ER_get      , 3, true);
+
+const tele_op_t op_XOR   = MAKE_PURE_ALIAS_OP(XOR, op_NE_get, 2, true);
+
+const tele_op_t op_SYM_PLUS               = MAKE_PURE_ALIAS_OP(+ , op_ADD_get, 2, true);
+const tele_op_t op_SYM_DASH               = MAKE_PURE_ALIAS_OP(- , op_SUB_get, 2, true);
+const tele_op_t op_SYM_STAR               = MAKE_PURE_ALIAS_OP(* , op_MUL_get, 2, true);
+const tele_op_t op_SYM_FORWARD_SLASH      = MAKE_PURE_ALIAS_OP(/ , op_DIV_get, 2, true);
+const tele_op_t op_SYM_PERCENTAGE         = MAKE_PURE_ALIAS_OP(% , op_MOD_get, 2, true);
+const tele_op_t op_SYM_EQUAL_x2           = MAKE_PURE_ALIAS_OP(==, op_EQ_get , 2, true);
+const tele_op_t op_SYM_EXCLAMATION_EQUAL  = MAKE_PURE_ALIAS_OP(!=, op_NE_get , 2, true);
+const tele_op_t op_SYM_LEFT_ANGLED        = MAKE_PURE_ALIAS_OP(< , op_LT_get , 2, true);
+const tele_op_t op_SYM_RIGHT_ANGLED       = MAKE_PURE_ALIAS_OP(> , op_GT_get , 2, true);
+const tele_op_t op_SYM_LEFT_ANGLED_EQUAL  = MAKE_PURE_ALIAS_OP(<=, op_LTE_get, 2, true);
+const tele_op_t op_SYM_RIGHT_ANGLED_EQUAL = MAKE_PURE_ALIAS_OP(>=, op_GTE_get, 2, true);
+const tele_op_t op_SYM_EXCLAMATION        = MAKE_PURE_ALIAS_OP(! , op_EZ_get , 1, true);
+const tele_op_t op_SYM_LEFT_ANGLED_x2     = MAKE_PURE_ALIAS_OP(<<, op_LSH_get, 2, true);
+const tele_op_t op_SYM_RIGHT_ANGLED_x2    = MAKE_PURE_ALIAS_OP(>>, op_RSH_get, 2, true);
+const tele_op_t op_SYM_AMPERSAND_x2       = MAKE_PURE_ALIAS_OP(&&, op_AND_get, 2, true);
+const tele_op_t op_SYM_PIPE_x2            = MAKE_PURE_ALIAS_OP(||, op_OR_get , 2, true);
 // clang-format on
 
 
 static void op_ADD_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) + cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a + b);
 }
 
 static void op_SUB_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) - cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a - b);
 }
 
 static void op_MUL_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) * cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a * b);
 }
 
 static void op_DIV_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
@@ -236,21 +242,15 @@ static void op_LIM_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
 
 static void op_WRAP_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                         exec_state_t *NOTUSED(es), command_state_t *cs) {
-    int16_t a, b, i, c;
-    i = cs_pop(cs);
-    a = cs_pop(cs);
-    b = cs_pop(cs);
-    if (a < b) {
-        c = b - a + 1;
-        while (i >= b) i -= c;
-        while (i < a) i += c;
-    }
-    else {
-        c = a - b + 1;
-        while (i >= a) i -= c;
-        while (i < b) i += c;
-    }
-    cs_push(cs, i);
+    int16_t i = cs_pop(cs);
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    // the range can be wider than an int16_t (e.g. WRAP X -32768 32767)
+    int32_t lo = a < b ? a : b;
+    int32_t c = (a < b ? b : a) - lo + 1;
+    int32_t r = (i - lo) % c;
+    if (r < 0) r += c;
+    cs_push(cs, lo + r);
 }
 
 static void op_QT_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
@@ -282,32 +282,44 @@ static void op_AVG_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
 
 static void op_EQ_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                       exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) == cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a == b);
 }
 
 static void op_NE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                       exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) != cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a != b);
 }
 
 static void op_LT_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                       exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) < cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a < b);
 }
 
 static void op_GT_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                       exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) > cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a > b);
 }
 
 static void op_LTE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) <= cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a <= b);
 }
 
 static void op_GTE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) >= cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a >= b);
 }
 
 static void op_NZ_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
@@ -322,12 +334,16 @@ static void op_EZ_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
 
 static void op_RSH_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) >> cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a >> b);
 }
 
 static void op_LSH_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                        exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, cs_pop(cs) << cs_pop(cs));
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    cs_push(cs, a << b);
 }
 
 static void op_EXP_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
@@ -377,7 +393,7 @@ static void op_JI_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
 
-    if (a == 0) {
+    if (a == 0 || b == 0) {
         cs_push(cs, 0);
         return;
     }
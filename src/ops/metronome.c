@@ -18,19 +18,65 @@ static void op_M_ACT_set(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
 static void op_M_RESET_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
+static void op_M_SCRIPT_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_M_SCRIPT_set(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_M_LATE_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_M_LATE_set(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_M_POL_get(const void *data, scene_state_t *ss, exec_state_t *es,
+                         command_state_t *cs);
+static void op_M_POL_set(const void *data, scene_state_t *ss, exec_state_t *es,
+                         command_state_t *cs);
+static void op_M_OVER_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_M_OVER_set(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_M_LOAD_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
 
-const tele_op_t op_M = MAKE_GET_SET_OP(M, op_M_get, op_M_set, 0, true);
+// M and M1 to M4 share their fns, data is the index into scene_state_t.metros
+#define MAKE_METRO_OP(n, g, s, r, i)                                   \
+    {                                                                  \
+        .name = #n, .get = g, .set = s, .params = 0, .returns = r,     \
+        .data = (void *)i                                              \
+    }
 
-static void op_M_get(const void *NOTUSED(data), scene_state_t *ss,
+// clang-format off
+const tele_op_t op_M       = MAKE_METRO_OP(M, op_M_get, op_M_set, true, 0);
+const tele_op_t op_M_ACT   = MAKE_METRO_OP(M.ACT, op_M_ACT_get, op_M_ACT_set, true, 0);
+const tele_op_t op_M_RESET = MAKE_METRO_OP(M.RESET, op_M_RESET_get, NULL, false, 0);
+
+const tele_op_t op_M1        = MAKE_METRO_OP(M1, op_M_get, op_M_set, true, 1);
+const tele_op_t op_M1_ACT    = MAKE_METRO_OP(M1.ACT, op_M_ACT_get, op_M_ACT_set, true, 1);
+const tele_op_t op_M1_RESET  = MAKE_METRO_OP(M1.RESET, op_M_RESET_get, NULL, false, 1);
+const tele_op_t op_M1_SCRIPT = MAKE_METRO_OP(M1.SCRIPT, op_M_SCRIPT_get, op_M_SCRIPT_set, true, 1);
+const tele_op_t op_M2        = MAKE_METRO_OP(M2, op_M_get, op_M_set, true, 2);
+const tele_op_t op_M2_ACT    = MAKE_METRO_OP(M2.ACT, op_M_ACT_get, op_M_ACT_set, true, 2);
+const tele_op_t op_M2_RESET  = MAKE_METRO_OP(M2.RESET, op_M_RESET_get, NULL, false, 2);
+const tele_op_t op_M2_SCRIPT = MAKE_METRO_OP(M2.SCRIPT, op_M_SCRIPT_get, op_M_SCRIPT_set, true, 2);
+const tele_op_t op_M3        = MAKE_METRO_OP(M3, op_M_get, op_M_set, true, 3);
+const tele_op_t op_M3_ACT    = MAKE_METRO_OP(M3.ACT, op_M_ACT_get, op_M_ACT_set, true, 3);
+const tele_op_t op_M3_RESET  = MAKE_METRO_OP(M3.RESET, op_M_RESET_get, NULL, false, 3);
+const tele_op_t op_M3_SCRIPT = MAKE_METRO_OP(M3.SCRIPT, op_M_SCRIPT_get, op_M_SCRIPT_set, true, 3);
+const tele_op_t op_M4        = MAKE_METRO_OP(M4, op_M_get, op_M_set, true, 4);
+const tele_op_t op_M4_ACT    = MAKE_METRO_OP(M4.ACT, op_M_ACT_get, op_M_ACT_set, true, 4);
+const tele_op_t op_M4_RESET  = MAKE_METRO_OP(M4.RESET, op_M_RESET_get, NULL, false, 4);
+const tele_op_t op_M4_SCRIPT = MAKE_METRO_OP(M4.SCRIPT, op_M_SCRIPT_get, op_M_SCRIPT_set, true, 4);
+// clang-format on
+
+static void op_M_get(const void *data, scene_state_t *ss,
                      exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, ss->variables.m);
+    cs_push(cs, ss->metros[(size_t)data].m);
 }
 
-static void op_M_set(const void *NOTUSED(data), scene_state_t *ss,
+static void op_M_set(const void *data, scene_state_t *ss,
                      exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t m = cs_pop(cs);
     if (m < METRO_MIN_MS) m = METRO_MIN_MS;
-    ss->variables.m = m;
+    ss->metros[(size_t)data].m = m;
     tele_metro_updated();
 }
 
@@ -44,7 +90,7 @@ static void op_M_SYM_EXCLAMATION_get(const void *NOTUSED(data),
                                      scene_state_t *ss,
                                      exec_state_t *NOTUSED(es),
                                      command_state_t *cs) {
-    cs_push(cs, ss->variables.m);
+    cs_push(cs, ss->metros[0].m);
 }
 
 static void op_M_SYM_EXCLAMATION_set(const void *NOTUSED(data),
@@ -53,31 +99,93 @@ static void op_M_SYM_EXCLAMATION_set(const void *NOTUSED(data),
                                      command_state_t *cs) {
     int16_t m = cs_pop(cs);
     if (m < METRO_MIN_UNSUPPORTED_MS) m = METRO_MIN_UNSUPPORTED_MS;
-    ss->variables.m = m;
+    ss->metros[0].m = m;
     tele_metro_updated();
 }
 
-const tele_op_t op_M_ACT =
-    MAKE_GET_SET_OP(M.ACT, op_M_ACT_get, op_M_ACT_set, 0, true);
-
-
-static void op_M_ACT_get(const void *NOTUSED(data), scene_state_t *ss,
+static void op_M_ACT_get(const void *data, scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, ss->variables.m_act);
+    cs_push(cs, ss->metros[(size_t)data].act);
 }
 
-static void op_M_ACT_set(const void *NOTUSED(data), scene_state_t *ss,
+static void op_M_ACT_set(const void *data, scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const size_t i = (size_t)data;
     bool m_act = cs_pop(cs) > 0;
-    ss->variables.m_act = m_act;
+    // start a whole period from now, rather than whatever was left of the
+    // period when it was stopped
+    if (m_act && !ss->metros[i].act) ss_reset_metro(ss, i);
+    ss->metros[i].act = m_act;
     tele_metro_updated();
 }
 
-const tele_op_t op_M_RESET = MAKE_GET_OP(M.RESET, op_M_RESET_get, 0, false);
-
-static void op_M_RESET_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+static void op_M_RESET_get(const void *data, scene_state_t *ss,
                            exec_state_t *NOTUSED(es),
                            command_state_t *NOTUSED(cs)) {
-    tele_metro_reset();
+    ss_reset_metro(ss, (size_t)data);
+}
+
+// scripts are numbered from 1 in ops
+static void op_M_SCRIPT_get(const void *data, scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->metros[(size_t)data].script + 1);
+}
+
+static void op_M_SCRIPT_set(const void *data, scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs) - 1;
+    if (a < 0 || a >= METRO_SCRIPT) return;
+    ss->metros[(size_t)data].script = a;
+}
+
+const tele_op_t op_M_LATE =
+    MAKE_GET_SET_OP(M.LATE, op_M_LATE_get, op_M_LATE_set, 0, true);
+
+static void op_M_LATE_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const uint32_t late = ss->metro_late / TICKS_PER_MS;
+    cs_push(cs, late > INT16_MAX ? INT16_MAX : late);
+}
+
+static void op_M_LATE_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t late = cs_pop(cs);
+    if (late < 0) late = 0;
+    ss->metro_late = (uint32_t)late * TICKS_PER_MS;
+}
+
+const tele_op_t op_M_POL =
+    MAKE_GET_SET_OP(M.POL, op_M_POL_get, op_M_POL_set, 0, true);
+
+static void op_M_POL_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->metro_policy);
+}
+
+static void op_M_POL_set(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t policy = cs_pop(cs);
+    if (policy < 0 || policy >= METRO_POLICY_COUNT) return;
+    ss->metro_policy = policy;
+}
+
+const tele_op_t op_M_OVER =
+    MAKE_GET_SET_OP(M.OVER, op_M_OVER_get, op_M_OVER_set, 0, true);
+
+static void op_M_OVER_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->metro_missed > INT16_MAX ? INT16_MAX : ss->metro_missed);
+}
+
+static void op_M_OVER_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t missed = cs_pop(cs);
+    ss->metro_missed = missed < 0 ? 0 : missed;
+}
+
+const tele_op_t op_M_LOAD = MAKE_GET_OP(M.LOAD, op_M_LOAD_get, 0, true);
+
+static void op_M_LOAD_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss_get_metro_load(ss));
 }
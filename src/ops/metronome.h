@@ -7,5 +7,25 @@ extern const tele_op_t op_M;
 extern const tele_op_t op_M_SYM_EXCLAMATION;
 extern const tele_op_t op_M_ACT;
 extern const tele_op_t op_M_RESET;
+extern const tele_op_t op_M_LATE;
+extern const tele_op_t op_M_POL;
+extern const tele_op_t op_M_OVER;
+extern const tele_op_t op_M_LOAD;
+extern const tele_op_t op_M1;
+extern const tele_op_t op_M1_ACT;
+extern const tele_op_t op_M1_RESET;
+extern const tele_op_t op_M1_SCRIPT;
+extern const tele_op_t op_M2;
+extern const tele_op_t op_M2_ACT;
+extern const tele_op_t op_M2_RESET;
+extern const tele_op_t op_M2_SCRIPT;
+extern const tele_op_t op_M3;
+extern const tele_op_t op_M3_ACT;
+extern const tele_op_t op_M3_RESET;
+extern const tele_op_t op_M3_SCRIPT;
+extern const tele_op_t op_M4;
+extern const tele_op_t op_M4_ACT;
+extern const tele_op_t op_M4_RESET;
+extern const tele_op_t op_M4_SCRIPT;
 
 #endif
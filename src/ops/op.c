@@ -3,7 +3,8 @@
 #include <stddef.h>  // offsetof
 
 #include "helpers.h"
-#include "teletype_io.h"
+#include "ii.h"
+#include "ii_bus.h"
 
 #include "ops/ansible.h"
 #include "ops/controlflow.h"
@@ -26,8 +27,9 @@
 /////////////////////////////////////////////////////////////////
 // OPS //////////////////////////////////////////////////////////
 
-// If you edit this array, you need to run 'utils/op_enums.py' to update the
-// values in 'op_enum.h' so that the order matches.
+// If you edit this array, or the definition of any op, you need to run
+// 'utils/op_enums.py' to update the values in 'op_enum.h' and 'op_table.c' so
+// that they match.
 const tele_op_t *tele_ops[E_OP__LENGTH] = {
     // variables
     &op_A, &op_B, &op_C, &op_D, &op_DRUNK, &op_DRUNK_MAX, &op_DRUNK_MIN,
@@ -35,22 +37,29 @@ const tele_op_t *tele_ops[E_OP__LENGTH] = {
     &op_O_WRAP, &op_T, &op_TIME, &op_TIME_ACT, &op_X, &op_Y, &op_Z,
 
     // metronome
-    &op_M, &op_M_SYM_EXCLAMATION, &op_M_ACT, &op_M_RESET,
+    &op_M, &op_M_SYM_EXCLAMATION, &op_M_ACT, &op_M_RESET, &op_M_LATE, &op_M_POL,
+    &op_M_OVER, &op_M_LOAD, &op_M1, &op_M1_ACT, &op_M1_RESET, &op_M1_SCRIPT,
+    &op_M2, &op_M2_ACT, &op_M2_RESET, &op_M2_SCRIPT, &op_M3, &op_M3_ACT,
+    &op_M3_RESET, &op_M3_SCRIPT, &op_M4, &op_M4_ACT, &op_M4_RESET,
+    &op_M4_SCRIPT,
 
     // patterns
     &op_P_N, &op_P, &op_PN, &op_P_L, &op_PN_L, &op_P_WRAP, &op_PN_WRAP,
     &op_P_START, &op_PN_START, &op_P_END, &op_PN_END, &op_P_I, &op_PN_I,
     &op_P_HERE, &op_PN_HERE, &op_P_NEXT, &op_PN_NEXT, &op_P_PREV, &op_PN_PREV,
     &op_P_INS, &op_PN_INS, &op_P_RM, &op_PN_RM, &op_P_PUSH, &op_PN_PUSH,
-    &op_P_POP, &op_PN_POP,
+    &op_P_POP, &op_PN_POP, &op_P_REV, &op_PN_REV, &op_P_ROT, &op_PN_ROT,
+    &op_P_SHUF, &op_PN_SHUF, &op_P_SUM, &op_PN_SUM, &op_P_MIN, &op_PN_MIN,
+    &op_P_MAX, &op_PN_MAX, &op_P_FIND, &op_PN_FIND, &op_P_ADD, &op_PN_ADD,
+    &op_P_SCALE, &op_PN_SCALE, &op_P_BANK,
 
     // queue
-    &op_Q, &op_Q_AVG, &op_Q_N,
+    &op_Q, &op_Q_AVG, &op_Q_N, &op_Q_MIN, &op_Q_MAX,
 
     // hardware
     &op_CV, &op_CV_OFF, &op_CV_SLEW, &op_IN, &op_PARAM, &op_PRM, &op_TR,
     &op_TR_POL, &op_TR_TIME, &op_TR_TOG, &op_TR_PULSE, &op_TR_P, &op_CV_SET,
-    &op_MUTE, &op_STATE,
+    &op_MUTE, &op_STATE, &op_II_FLUSH, &op_II_POLL, &op_II_REFRESH,
 
     // maths
     &op_ADD, &op_SUB, &op_MUL, &op_DIV, &op_MOD, &op_RAND, &op_RRAND, &op_TOSS,
@@ -189,5 +198,53 @@ void op_simple_i2c(const void *data, scene_state_t *NOTUSED(ss),
 
     uint8_t buffer[3] = { message_type, value >> 8, value & 0xFF };
 
-    tele_ii_tx(address, buffer, 3);
+    ii_tx(address, buffer, 3);
+}
+
+// sends cmd followed by the first n params, see tele_ii_op_t.wide
+static void ii_op_send(const tele_ii_op_t *op, uint8_t cmd, uint8_t n,
+                       command_state_t *cs) {
+    uint8_t d[II_TX_MAX_LENGTH];
+    uint8_t l = 0;
+    d[l++] = cmd;
+    for (uint8_t i = 0; i < n; i++) {
+        int16_t value = cs_pop(cs);
+        if (op->wide & (1 << i)) d[l++] = value >> 8;
+        d[l++] = value & 0xff;
+    }
+    ii_tx(op->addr, d, l);
+}
+
+void op_ii_get(const void *data, scene_state_t *NOTUSED(ss),
+               exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const tele_ii_op_t *op = data;
+    switch (op->layout) {
+        case II_OP_TX_OUTPUT:
+        case II_OP_TX_DEVICE: {
+            uint8_t output = cs_pop(cs);
+            if (op->layout == II_OP_TX_DEVICE) output = DeviceToOutput(output);
+            if (op->params == 2)
+                TXSend(op->addr, op->cmd, output, cs_pop(cs), true);
+            else
+                TXCmd(op->addr, op->cmd, output);
+            break;
+        }
+        case II_OP_TX_INPUT: TXReceive(op->addr, cs, op->cmd); break;
+        default:
+            if (op->read == 0) {
+                ii_op_send(op, op->cmd, op->params, cs);
+                break;
+            }
+            ii_op_send(op, op->cmd | II_GET, op->params, cs);
+            uint8_t d[2] = { 0, 0 };
+            ii_rx(op->addr, d, op->read);
+            cs_push(cs, op->read == 2 ? (d[0] << 8) + d[1] : d[0]);
+            break;
+    }
+}
+
+void op_ii_set(const void *data, scene_state_t *NOTUSED(ss),
+               exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const tele_ii_op_t *op = data;
+    ii_op_send(op, op->cmd, op->params + 1, cs);
 }
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+#include "bytecode.h"
 #include "command.h"
 #include "op_enum.h"
 #include "state.h"
@@ -17,18 +18,33 @@ typedef struct {
     const uint8_t params;
     const bool returns;
     const void *data;
+    // a pure op only depends on its params, it must not read or modify the
+    // scene or exec state, so it can be evaluated when a command is compiled,
+    // it must give a result for any params (e.g. 0 when dividing by 0)
+    const bool pure;
 } tele_op_t;
 
 typedef struct {
     const char *name;
     void (*const func)(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
-                       const tele_command_t *post_command);
+                       const tele_command_view_t *post_command);
     const uint8_t params;
 } tele_mod_t;
 
 extern const tele_op_t *tele_ops[E_OP__LENGTH];
 extern const tele_mod_t *tele_mods[E_MOD__LENGTH];
 
+// The fields of each op needed to validate and compile a command, as parallel
+// arrays indexed by tele_op_idx_t, so that those loops don't have to follow
+// every pointer in tele_ops. They are generated from the op definitions in
+// 'op_table.c' by 'utils/op_enums.py', tele_ops is still the complete view.
+#define OP_FLAG_RETURNS 0x01
+#define OP_FLAG_SET 0x02  // has a set fn
+#define OP_FLAG_PURE 0x04  // pure and can be folded, see fold_pure_op
+
+extern const uint8_t tele_op_params[E_OP__LENGTH];
+extern const uint8_t tele_op_flags[E_OP__LENGTH];
+
 // Get only ops
 #define MAKE_GET_OP(n, g, p, r)                                       \
     {                                                                 \
@@ -37,6 +53,14 @@ extern const tele_mod_t *tele_mods[E_MOD__LENGTH];
     }
 
 
+// Pure get only ops (see tele_op_t.pure)
+#define MAKE_PURE_OP(n, g, p, r)                                      \
+    {                                                                 \
+        .name = #n, .get = g, .set = NULL, .params = p, .returns = r, \
+        .data = NULL, .pure = true                                    \
+    }
+
+
 // Get & set ops
 #define MAKE_GET_SET_OP(n, g, s, p, r) \
     { .name = #n, .get = g, .set = s, .params = p, .returns = r, .data = NULL }
@@ -60,6 +84,10 @@ void op_poke_i16(const void *data, scene_state_t *ss, exec_state_t *es,
     { .name = #n, .get = g, .set = s, .params = p, .returns = r, .data = NULL }
 
 
+// Alias one OP to a pure get only OP
+#define MAKE_PURE_ALIAS_OP(n, g, p, r) MAKE_PURE_OP(n, g, p, r)
+
+
 // Simple I2C op (to support the original Trilogy modules)
 #define MAKE_SIMPLE_I2C_OP(n, v)                                    \
     {                                                               \
@@ -71,6 +99,43 @@ void op_simple_i2c(const void *data, scene_state_t *ss, exec_state_t *es,
                    command_state_t *cs);
 
 
+// ii ops that only send a message to a follower (or send one and read back the
+// reply) are described by a tele_ii_op_t rather than code, they are generated
+// into 'ii_ops.c' by 'utils/ii_ops.py' from the ii entries in 'docs/ops/*.toml'
+typedef enum {
+    II_OP_BYTES,      // each param is sent after cmd as 1 or 2 bytes
+    II_OP_TX_OUTPUT,  // a TELEX output, and the value to set it to
+    II_OP_TX_DEVICE,  // a TELEX device, and the value to set it to
+    II_OP_TX_INPUT    // reads a TELEX input, cmd is TI_IN, TI_PARAM_QT, etc
+} tele_ii_layout_t;
+
+typedef struct {
+    uint8_t addr;    // the base address for TELEX ops
+    uint8_t cmd;
+    uint8_t layout;  // tele_ii_layout_t
+    uint8_t params;  // the number the get pops, the set pops one more
+    uint8_t wide;    // II_OP_BYTES: bit n is set if param n is 2 bytes
+    uint8_t read;    // II_OP_BYTES: the number of bytes the get reads
+} tele_ii_op_t;
+
+#define MAKE_II_OP(n, d, p, r)                                  \
+    {                                                           \
+        .name = #n, .get = op_ii_get, .set = NULL, .params = p, \
+        .returns = r, .data = d                                 \
+    }
+
+#define MAKE_II_GET_SET_OP(n, d, p)                                  \
+    {                                                                \
+        .name = #n, .get = op_ii_get, .set = op_ii_set, .params = p, \
+        .returns = true, .data = d                                   \
+    }
+
+void op_ii_get(const void *data, scene_state_t *ss, exec_state_t *es,
+               command_state_t *cs);
+void op_ii_set(const void *data, scene_state_t *ss, exec_state_t *es,
+               command_state_t *cs);
+
+
 // Mods
 #define MAKE_MOD(n, f, p) \
     { .name = #n, .func = f, .params = p }
@@ -31,6 +31,26 @@ typedef enum {
     E_OP_M_SYM_EXCLAMATION,
     E_OP_M_ACT,
     E_OP_M_RESET,
+    E_OP_M_LATE,
+    E_OP_M_POL,
+    E_OP_M_OVER,
+    E_OP_M_LOAD,
+    E_OP_M1,
+    E_OP_M1_ACT,
+    E_OP_M1_RESET,
+    E_OP_M1_SCRIPT,
+    E_OP_M2,
+    E_OP_M2_ACT,
+    E_OP_M2_RESET,
+    E_OP_M2_SCRIPT,
+    E_OP_M3,
+    E_OP_M3_ACT,
+    E_OP_M3_RESET,
+    E_OP_M3_SCRIPT,
+    E_OP_M4,
+    E_OP_M4_ACT,
+    E_OP_M4_RESET,
+    E_OP_M4_SCRIPT,
     E_OP_P_N,
     E_OP_P,
     E_OP_PN,
@@ -58,9 +78,30 @@ typedef enum {
     E_OP_PN_PUSH,
     E_OP_P_POP,
     E_OP_PN_POP,
+    E_OP_P_REV,
+    E_OP_PN_REV,
+    E_OP_P_ROT,
+    E_OP_PN_ROT,
+    E_OP_P_SHUF,
+    E_OP_PN_SHUF,
+    E_OP_P_SUM,
+    E_OP_PN_SUM,
+    E_OP_P_MIN,
+    E_OP_PN_MIN,
+    E_OP_P_MAX,
+    E_OP_PN_MAX,
+    E_OP_P_FIND,
+    E_OP_PN_FIND,
+    E_OP_P_ADD,
+    E_OP_PN_ADD,
+    E_OP_P_SCALE,
+    E_OP_PN_SCALE,
+    E_OP_P_BANK,
     E_OP_Q,
     E_OP_Q_AVG,
     E_OP_Q_N,
+    E_OP_Q_MIN,
+    E_OP_Q_MAX,
     E_OP_CV,
     E_OP_CV_OFF,
     E_OP_CV_SLEW,
@@ -76,6 +117,9 @@ typedef enum {
     E_OP_CV_SET,
     E_OP_MUTE,
     E_OP_STATE,
+    E_OP_II_FLUSH,
+    E_OP_II_POLL,
+    E_OP_II_REFRESH,
     E_OP_ADD,
     E_OP_SUB,
     E_OP_MUL,
@@ -0,0 +1,750 @@
+// clang-format off
+
+#include "ops/op.h"
+
+// This file has been autogenerated by 'utils/op_enums.py'
+
+const uint8_t tele_op_params[E_OP__LENGTH] = {
+    0,  // E_OP_A
+    0,  // E_OP_B
+    0,  // E_OP_C
+    0,  // E_OP_D
+    0,  // E_OP_DRUNK
+    0,  // E_OP_DRUNK_MAX
+    0,  // E_OP_DRUNK_MIN
+    0,  // E_OP_DRUNK_WRAP
+    0,  // E_OP_FLIP
+    0,  // E_OP_I
+    0,  // E_OP_O
+    0,  // E_OP_O_INC
+    0,  // E_OP_O_MAX
+    0,  // E_OP_O_MIN
+    0,  // E_OP_O_WRAP
+    0,  // E_OP_T
+    0,  // E_OP_TIME
+    0,  // E_OP_TIME_ACT
+    0,  // E_OP_X
+    0,  // E_OP_Y
+    0,  // E_OP_Z
+    0,  // E_OP_M
+    0,  // E_OP_M_SYM_EXCLAMATION
+    0,  // E_OP_M_ACT
+    0,  // E_OP_M_RESET
+    0,  // E_OP_M_LATE
+    0,  // E_OP_M_POL
+    0,  // E_OP_M_OVER
+    0,  // E_OP_M_LOAD
+    0,  // E_OP_M1
+    0,  // E_OP_M1_ACT
+    0,  // E_OP_M1_RESET
+    0,  // E_OP_M1_SCRIPT
+    0,  // E_OP_M2
+    0,  // E_OP_M2_ACT
+    0,  // E_OP_M2_RESET
+    0,  // E_OP_M2_SCRIPT
+    0,  // E_OP_M3
+    0,  // E_OP_M3_ACT
+    0,  // E_OP_M3_RESET
+    0,  // E_OP_M3_SCRIPT
+    0,  // E_OP_M4
+    0,  // E_OP_M4_ACT
+    0,  // E_OP_M4_RESET
+    0,  // E_OP_M4_SCRIPT
+    0,  // E_OP_P_N
+    1,  // E_OP_P
+    2,  // E_OP_PN
+    0,  // E_OP_P_L
+    1,  // E_OP_PN_L
+    0,  // E_OP_P_WRAP
+    1,  // E_OP_PN_WRAP
+    0,  // E_OP_P_START
+    1,  // E_OP_PN_START
+    0,  // E_OP_P_END
+    1,  // E_OP_PN_END
+    0,  // E_OP_P_I
+    1,  // E_OP_PN_I
+    0,  // E_OP_P_HERE
+    1,  // E_OP_PN_HERE
+    0,  // E_OP_P_NEXT
+    1,  // E_OP_PN_NEXT
+    0,  // E_OP_P_PREV
+    1,  // E_OP_PN_PREV
+    2,  // E_OP_P_INS
+    3,  // E_OP_PN_INS
+    1,  // E_OP_P_RM
+    2,  // E_OP_PN_RM
+    1,  // E_OP_P_PUSH
+    2,  // E_OP_PN_PUSH
+    0,  // E_OP_P_POP
+    1,  // E_OP_PN_POP
+    0,  // E_OP_P_REV
+    1,  // E_OP_PN_REV
+    1,  // E_OP_P_ROT
+    2,  // E_OP_PN_ROT
+    0,  // E_OP_P_SHUF
+    1,  // E_OP_PN_SHUF
+    0,  // E_OP_P_SUM
+    1,  // E_OP_PN_SUM
+    0,  // E_OP_P_MIN
+    1,  // E_OP_PN_MIN
+    0,  // E_OP_P_MAX
+    1,  // E_OP_PN_MAX
+    1,  // E_OP_P_FIND
+    2,  // E_OP_PN_FIND
+    1,  // E_OP_P_ADD
+    2,  // E_OP_PN_ADD
+    4,  // E_OP_P_SCALE
+    5,  // E_OP_PN_SCALE
+    0,  // E_OP_P_BANK
+    0,  // E_OP_Q
+    0,  // E_OP_Q_AVG
+    0,  // E_OP_Q_N
+    0,  // E_OP_Q_MIN
+    0,  // E_OP_Q_MAX
+    1,  // E_OP_CV
+    1,  // E_OP_CV_OFF
+    1,  // E_OP_CV_SLEW
+    0,  // E_OP_IN
+    0,  // E_OP_PARAM
+    0,  // E_OP_PRM
+    1,  // E_OP_TR
+    1,  // E_OP_TR_POL
+    1,  // E_OP_TR_TIME
+    1,  // E_OP_TR_TOG
+    1,  // E_OP_TR_PULSE
+    1,  // E_OP_TR_P
+    2,  // E_OP_CV_SET
+    1,  // E_OP_MUTE
+    1,  // E_OP_STATE
+    0,  // E_OP_II_FLUSH
+    0,  // E_OP_II_POLL
+    0,  // E_OP_II_REFRESH
+    2,  // E_OP_ADD
+    2,  // E_OP_SUB
+    2,  // E_OP_MUL
+    2,  // E_OP_DIV
+    2,  // E_OP_MOD
+    1,  // E_OP_RAND
+    2,  // E_OP_RRAND
+    0,  // E_OP_TOSS
+    2,  // E_OP_MIN
+    2,  // E_OP_MAX
+    3,  // E_OP_LIM
+    3,  // E_OP_WRAP
+    2,  // E_OP_QT
+    2,  // E_OP_AVG
+    2,  // E_OP_EQ
+    2,  // E_OP_NE
+    2,  // E_OP_LT
+    2,  // E_OP_GT
+    2,  // E_OP_LTE
+    2,  // E_OP_GTE
+    1,  // E_OP_NZ
+    1,  // E_OP_EZ
+    2,  // E_OP_RSH
+    2,  // E_OP_LSH
+    1,  // E_OP_EXP
+    1,  // E_OP_ABS
+    2,  // E_OP_AND
+    2,  // E_OP_OR
+    2,  // E_OP_JI
+    5,  // E_OP_SCALE
+    1,  // E_OP_N
+    1,  // E_OP_V
+    1,  // E_OP_VV
+    3,  // E_OP_ER
+    2,  // E_OP_XOR
+    2,  // E_OP_SYM_PLUS
+    2,  // E_OP_SYM_DASH
+    2,  // E_OP_SYM_STAR
+    2,  // E_OP_SYM_FORWARD_SLASH
+    2,  // E_OP_SYM_PERCENTAGE
+    2,  // E_OP_SYM_EQUAL_x2
+    2,  // E_OP_SYM_EXCLAMATION_EQUAL
+    2,  // E_OP_SYM_LEFT_ANGLED
+    2,  // E_OP_SYM_RIGHT_ANGLED
+    2,  // E_OP_SYM_LEFT_ANGLED_EQUAL
+    2,  // E_OP_SYM_RIGHT_ANGLED_EQUAL
+    1,  // E_OP_SYM_EXCLAMATION
+    2,  // E_OP_SYM_LEFT_ANGLED_x2
+    2,  // E_OP_SYM_RIGHT_ANGLED_x2
+    2,  // E_OP_SYM_AMPERSAND_x2
+    2,  // E_OP_SYM_PIPE_x2
+    0,  // E_OP_S_ALL
+    0,  // E_OP_S_POP
+    0,  // E_OP_S_CLR
+    0,  // E_OP_S_L
+    1,  // E_OP_SCRIPT
+    0,  // E_OP_KILL
+    0,  // E_OP_SCENE
+    0,  // E_OP_DEL_CLR
+    1,  // E_OP_WW_PRESET
+    1,  // E_OP_WW_POS
+    1,  // E_OP_WW_SYNC
+    1,  // E_OP_WW_START
+    1,  // E_OP_WW_END
+    1,  // E_OP_WW_PMODE
+    1,  // E_OP_WW_PATTERN
+    1,  // E_OP_WW_QPATTERN
+    1,  // E_OP_WW_MUTE1
+    1,  // E_OP_WW_MUTE2
+    1,  // E_OP_WW_MUTE3
+    1,  // E_OP_WW_MUTE4
+    1,  // E_OP_WW_MUTEA
+    1,  // E_OP_WW_MUTEB
+    1,  // E_OP_MP_PRESET
+    1,  // E_OP_MP_RESET
+    1,  // E_OP_MP_STOP
+    1,  // E_OP_ES_PRESET
+    1,  // E_OP_ES_MODE
+    1,  // E_OP_ES_CLOCK
+    1,  // E_OP_ES_RESET
+    1,  // E_OP_ES_PATTERN
+    1,  // E_OP_ES_TRANS
+    1,  // E_OP_ES_STOP
+    1,  // E_OP_ES_TRIPLE
+    1,  // E_OP_ES_MAGIC
+    1,  // E_OP_OR_TRK
+    1,  // E_OP_OR_CLK
+    1,  // E_OP_OR_DIV
+    1,  // E_OP_OR_PHASE
+    1,  // E_OP_OR_RST
+    1,  // E_OP_OR_WGT
+    1,  // E_OP_OR_MUTE
+    1,  // E_OP_OR_SCALE
+    1,  // E_OP_OR_BANK
+    1,  // E_OP_OR_PRESET
+    1,  // E_OP_OR_RELOAD
+    1,  // E_OP_OR_ROTS
+    1,  // E_OP_OR_ROTW
+    1,  // E_OP_OR_GRST
+    1,  // E_OP_OR_CVA
+    1,  // E_OP_OR_CVB
+    0,  // E_OP_KR_PRE
+    0,  // E_OP_KR_PAT
+    0,  // E_OP_KR_SCALE
+    0,  // E_OP_KR_PERIOD
+    2,  // E_OP_KR_POS
+    2,  // E_OP_KR_L_ST
+    2,  // E_OP_KR_L_LEN
+    2,  // E_OP_KR_RES
+    0,  // E_OP_ME_PRE
+    1,  // E_OP_ME_RES
+    1,  // E_OP_ME_STOP
+    0,  // E_OP_ME_SCALE
+    0,  // E_OP_ME_PERIOD
+    0,  // E_OP_LV_PRE
+    1,  // E_OP_LV_RES
+    0,  // E_OP_LV_POS
+    0,  // E_OP_LV_L_ST
+    0,  // E_OP_LV_L_LEN
+    0,  // E_OP_LV_L_DIR
+    1,  // E_OP_LV_CV
+    0,  // E_OP_CY_PRE
+    1,  // E_OP_CY_RES
+    1,  // E_OP_CY_POS
+    1,  // E_OP_CY_REV
+    1,  // E_OP_CY_CV
+    1,  // E_OP_MID_SHIFT
+    1,  // E_OP_MID_SLEW
+    1,  // E_OP_ARP_STY
+    1,  // E_OP_ARP_HLD
+    3,  // E_OP_ARP_RPT
+    2,  // E_OP_ARP_GT
+    2,  // E_OP_ARP_DIV
+    1,  // E_OP_ARP_RES
+    2,  // E_OP_ARP_SHIFT
+    2,  // E_OP_ARP_SLEW
+    2,  // E_OP_ARP_FIL
+    2,  // E_OP_ARP_ROT
+    4,  // E_OP_ARP_ER
+    2,  // E_OP_JF_TR
+    1,  // E_OP_JF_RMODE
+    1,  // E_OP_JF_RUN
+    1,  // E_OP_JF_SHIFT
+    2,  // E_OP_JF_VTR
+    1,  // E_OP_JF_MODE
+    1,  // E_OP_JF_TICK
+    3,  // E_OP_JF_VOX
+    2,  // E_OP_JF_NOTE
+    1,  // E_OP_JF_GOD
+    3,  // E_OP_JF_TUNE
+    1,  // E_OP_JF_QT
+    2,  // E_OP_TO_TR
+    1,  // E_OP_TO_TR_TOG
+    1,  // E_OP_TO_TR_PULSE
+    2,  // E_OP_TO_TR_TIME
+    2,  // E_OP_TO_TR_TIME_S
+    2,  // E_OP_TO_TR_TIME_M
+    2,  // E_OP_TO_TR_POL
+    1,  // E_OP_TO_KILL
+    2,  // E_OP_TO_TR_PULSE_DIV
+    2,  // E_OP_TO_TR_PULSE_MUTE
+    2,  // E_OP_TO_TR_M_MUL
+    2,  // E_OP_TO_M
+    2,  // E_OP_TO_M_S
+    2,  // E_OP_TO_M_M
+    2,  // E_OP_TO_M_BPM
+    2,  // E_OP_TO_M_ACT
+    1,  // E_OP_TO_M_SYNC
+    2,  // E_OP_TO_M_COUNT
+    2,  // E_OP_TO_TR_M
+    2,  // E_OP_TO_TR_M_S
+    2,  // E_OP_TO_TR_M_M
+    2,  // E_OP_TO_TR_M_BPM
+    2,  // E_OP_TO_TR_M_ACT
+    1,  // E_OP_TO_TR_M_SYNC
+    2,  // E_OP_TO_TR_WIDTH
+    2,  // E_OP_TO_TR_M_COUNT
+    2,  // E_OP_TO_CV
+    2,  // E_OP_TO_CV_SLEW
+    2,  // E_OP_TO_CV_SLEW_S
+    2,  // E_OP_TO_CV_SLEW_M
+    2,  // E_OP_TO_CV_SET
+    2,  // E_OP_TO_CV_OFF
+    2,  // E_OP_TO_CV_QT
+    2,  // E_OP_TO_CV_QT_SET
+    2,  // E_OP_TO_CV_N
+    2,  // E_OP_TO_CV_N_SET
+    2,  // E_OP_TO_CV_SCALE
+    2,  // E_OP_TO_CV_LOG
+    1,  // E_OP_TO_CV_INIT
+    1,  // E_OP_TO_TR_INIT
+    1,  // E_OP_TO_INIT
+    1,  // E_OP_TO_TR_P
+    2,  // E_OP_TO_TR_P_DIV
+    2,  // E_OP_TO_TR_P_MUTE
+    2,  // E_OP_TO_OSC
+    2,  // E_OP_TO_OSC_SET
+    2,  // E_OP_TO_OSC_QT
+    2,  // E_OP_TO_OSC_QT_SET
+    2,  // E_OP_TO_OSC_FQ
+    2,  // E_OP_TO_OSC_FQ_SET
+    2,  // E_OP_TO_OSC_N
+    2,  // E_OP_TO_OSC_N_SET
+    2,  // E_OP_TO_OSC_LFO
+    2,  // E_OP_TO_OSC_LFO_SET
+    2,  // E_OP_TO_OSC_WAVE
+    1,  // E_OP_TO_OSC_SYNC
+    2,  // E_OP_TO_OSC_PHASE
+    2,  // E_OP_TO_OSC_WIDTH
+    2,  // E_OP_TO_OSC_RECT
+    2,  // E_OP_TO_OSC_SLEW
+    2,  // E_OP_TO_OSC_SLEW_S
+    2,  // E_OP_TO_OSC_SLEW_M
+    2,  // E_OP_TO_OSC_SCALE
+    2,  // E_OP_TO_OSC_CYC
+    2,  // E_OP_TO_OSC_CYC_S
+    2,  // E_OP_TO_OSC_CYC_M
+    2,  // E_OP_TO_OSC_CYC_SET
+    2,  // E_OP_TO_OSC_CYC_S_SET
+    2,  // E_OP_TO_OSC_CYC_M_SET
+    2,  // E_OP_TO_OSC_CTR
+    2,  // E_OP_TO_ENV_ACT
+    2,  // E_OP_TO_ENV_ATT
+    2,  // E_OP_TO_ENV_ATT_S
+    2,  // E_OP_TO_ENV_ATT_M
+    2,  // E_OP_TO_ENV_DEC
+    2,  // E_OP_TO_ENV_DEC_S
+    2,  // E_OP_TO_ENV_DEC_M
+    1,  // E_OP_TO_ENV_TRIG
+    2,  // E_OP_TO_ENV_EOR
+    2,  // E_OP_TO_ENV_EOC
+    2,  // E_OP_TO_ENV_LOOP
+    1,  // E_OP_TI_PARAM
+    1,  // E_OP_TI_PARAM_QT
+    1,  // E_OP_TI_PARAM_N
+    2,  // E_OP_TI_PARAM_SCALE
+    3,  // E_OP_TI_PARAM_MAP
+    1,  // E_OP_TI_IN
+    1,  // E_OP_TI_IN_QT
+    1,  // E_OP_TI_IN_N
+    2,  // E_OP_TI_IN_SCALE
+    3,  // E_OP_TI_IN_MAP
+    2,  // E_OP_TI_PARAM_CALIB
+    2,  // E_OP_TI_IN_CALIB
+    1,  // E_OP_TI_STORE
+    1,  // E_OP_TI_RESET
+    1,  // E_OP_TI_PARAM_INIT
+    1,  // E_OP_TI_IN_INIT
+    1,  // E_OP_TI_INIT
+    1,  // E_OP_TI_PRM
+    1,  // E_OP_TI_PRM_QT
+    1,  // E_OP_TI_PRM_N
+    2,  // E_OP_TI_PRM_SCALE
+    3,  // E_OP_TI_PRM_MAP
+    1,  // E_OP_TI_PRM_INIT
+};
+
+const uint8_t tele_op_flags[E_OP__LENGTH] = {
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_A
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_B
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_C
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_D
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_DRUNK
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_DRUNK_MAX
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_DRUNK_MIN
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_DRUNK_WRAP
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_FLIP
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_I
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_O
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_O_INC
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_O_MAX
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_O_MIN
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_O_WRAP
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_T
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_TIME
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_TIME_ACT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_X
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_Y
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_Z
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M_SYM_EXCLAMATION
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M_ACT
+    0,  // E_OP_M_RESET
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M_LATE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M_POL
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M_OVER
+    OP_FLAG_RETURNS,  // E_OP_M_LOAD
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M1
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M1_ACT
+    0,  // E_OP_M1_RESET
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M1_SCRIPT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M2
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M2_ACT
+    0,  // E_OP_M2_RESET
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M2_SCRIPT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M3
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M3_ACT
+    0,  // E_OP_M3_RESET
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M3_SCRIPT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M4
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M4_ACT
+    0,  // E_OP_M4_RESET
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_M4_SCRIPT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_N
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_L
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_L
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_WRAP
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_WRAP
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_START
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_START
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_END
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_END
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_I
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_I
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_HERE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_HERE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_NEXT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_NEXT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_PREV
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_PN_PREV
+    0,  // E_OP_P_INS
+    0,  // E_OP_PN_INS
+    OP_FLAG_RETURNS,  // E_OP_P_RM
+    OP_FLAG_RETURNS,  // E_OP_PN_RM
+    0,  // E_OP_P_PUSH
+    0,  // E_OP_PN_PUSH
+    OP_FLAG_RETURNS,  // E_OP_P_POP
+    OP_FLAG_RETURNS,  // E_OP_PN_POP
+    0,  // E_OP_P_REV
+    0,  // E_OP_PN_REV
+    0,  // E_OP_P_ROT
+    0,  // E_OP_PN_ROT
+    0,  // E_OP_P_SHUF
+    0,  // E_OP_PN_SHUF
+    OP_FLAG_RETURNS,  // E_OP_P_SUM
+    OP_FLAG_RETURNS,  // E_OP_PN_SUM
+    OP_FLAG_RETURNS,  // E_OP_P_MIN
+    OP_FLAG_RETURNS,  // E_OP_PN_MIN
+    OP_FLAG_RETURNS,  // E_OP_P_MAX
+    OP_FLAG_RETURNS,  // E_OP_PN_MAX
+    OP_FLAG_RETURNS,  // E_OP_P_FIND
+    OP_FLAG_RETURNS,  // E_OP_PN_FIND
+    0,  // E_OP_P_ADD
+    0,  // E_OP_PN_ADD
+    0,  // E_OP_P_SCALE
+    0,  // E_OP_PN_SCALE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_P_BANK
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_Q
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_Q_AVG
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_Q_N
+    OP_FLAG_RETURNS,  // E_OP_Q_MIN
+    OP_FLAG_RETURNS,  // E_OP_Q_MAX
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_CV
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_CV_OFF
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_CV_SLEW
+    OP_FLAG_RETURNS,  // E_OP_IN
+    OP_FLAG_RETURNS,  // E_OP_PARAM
+    OP_FLAG_RETURNS,  // E_OP_PRM
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_TR
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_TR_POL
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_TR_TIME
+    0,  // E_OP_TR_TOG
+    0,  // E_OP_TR_PULSE
+    0,  // E_OP_TR_P
+    0,  // E_OP_CV_SET
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_MUTE
+    OP_FLAG_RETURNS,  // E_OP_STATE
+    0,  // E_OP_II_FLUSH
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_II_POLL
+    0,  // E_OP_II_REFRESH
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_ADD
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SUB
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_MUL
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_DIV
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_MOD
+    OP_FLAG_RETURNS,  // E_OP_RAND
+    OP_FLAG_RETURNS,  // E_OP_RRAND
+    OP_FLAG_RETURNS,  // E_OP_TOSS
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_MIN
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_MAX
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_LIM
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_WRAP
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_QT
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_AVG
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_EQ
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_NE
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_LT
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_GT
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_LTE
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_GTE
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_NZ
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_EZ
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_RSH
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_LSH
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_EXP
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_ABS
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_AND
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_OR
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_JI
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SCALE
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_N
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_V
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_VV
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_ER
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_XOR
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_PLUS
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_DASH
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_STAR
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_FORWARD_SLASH
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_PERCENTAGE
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_EQUAL_x2
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_EXCLAMATION_EQUAL
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_LEFT_ANGLED
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_RIGHT_ANGLED
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_LEFT_ANGLED_EQUAL
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_RIGHT_ANGLED_EQUAL
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_EXCLAMATION
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_LEFT_ANGLED_x2
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_RIGHT_ANGLED_x2
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_AMPERSAND_x2
+    OP_FLAG_RETURNS | OP_FLAG_PURE,  // E_OP_SYM_PIPE_x2
+    0,  // E_OP_S_ALL
+    0,  // E_OP_S_POP
+    0,  // E_OP_S_CLR
+    OP_FLAG_RETURNS,  // E_OP_S_L
+    0,  // E_OP_SCRIPT
+    0,  // E_OP_KILL
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_SCENE
+    0,  // E_OP_DEL_CLR
+    0,  // E_OP_WW_PRESET
+    0,  // E_OP_WW_POS
+    0,  // E_OP_WW_SYNC
+    0,  // E_OP_WW_START
+    0,  // E_OP_WW_END
+    0,  // E_OP_WW_PMODE
+    0,  // E_OP_WW_PATTERN
+    0,  // E_OP_WW_QPATTERN
+    0,  // E_OP_WW_MUTE1
+    0,  // E_OP_WW_MUTE2
+    0,  // E_OP_WW_MUTE3
+    0,  // E_OP_WW_MUTE4
+    0,  // E_OP_WW_MUTEA
+    0,  // E_OP_WW_MUTEB
+    0,  // E_OP_MP_PRESET
+    0,  // E_OP_MP_RESET
+    0,  // E_OP_MP_STOP
+    0,  // E_OP_ES_PRESET
+    0,  // E_OP_ES_MODE
+    0,  // E_OP_ES_CLOCK
+    0,  // E_OP_ES_RESET
+    0,  // E_OP_ES_PATTERN
+    0,  // E_OP_ES_TRANS
+    0,  // E_OP_ES_STOP
+    0,  // E_OP_ES_TRIPLE
+    0,  // E_OP_ES_MAGIC
+    0,  // E_OP_OR_TRK
+    0,  // E_OP_OR_CLK
+    0,  // E_OP_OR_DIV
+    0,  // E_OP_OR_PHASE
+    0,  // E_OP_OR_RST
+    0,  // E_OP_OR_WGT
+    0,  // E_OP_OR_MUTE
+    0,  // E_OP_OR_SCALE
+    0,  // E_OP_OR_BANK
+    0,  // E_OP_OR_PRESET
+    0,  // E_OP_OR_RELOAD
+    0,  // E_OP_OR_ROTS
+    0,  // E_OP_OR_ROTW
+    0,  // E_OP_OR_GRST
+    0,  // E_OP_OR_CVA
+    0,  // E_OP_OR_CVB
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_PRE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_PAT
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_SCALE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_PERIOD
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_POS
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_L_ST
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_KR_L_LEN
+    0,  // E_OP_KR_RES
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_ME_PRE
+    0,  // E_OP_ME_RES
+    0,  // E_OP_ME_STOP
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_ME_SCALE
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_ME_PERIOD
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_LV_PRE
+    0,  // E_OP_LV_RES
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_LV_POS
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_LV_L_ST
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_LV_L_LEN
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_LV_L_DIR
+    OP_FLAG_RETURNS,  // E_OP_LV_CV
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_CY_PRE
+    0,  // E_OP_CY_RES
+    OP_FLAG_RETURNS | OP_FLAG_SET,  // E_OP_CY_POS
+    0,  // E_OP_CY_REV
+    OP_FLAG_RETURNS,  // E_OP_CY_CV
+    0,  // E_OP_MID_SHIFT
+    0,  // E_OP_MID_SLEW
+    0,  // E_OP_ARP_STY
+    0,  // E_OP_ARP_HLD
+    0,  // E_OP_ARP_RPT
+    0,  // E_OP_ARP_GT
+    0,  // E_OP_ARP_DIV
+    0,  // E_OP_ARP_RES
+    0,  // E_OP_ARP_SHIFT
+    0,  // E_OP_ARP_SLEW
+    0,  // E_OP_ARP_FIL
+    0,  // E_OP_ARP_ROT
+    0,  // E_OP_ARP_ER
+    0,  // E_OP_JF_TR
+    0,  // E_OP_JF_RMODE
+    0,  // E_OP_JF_RUN
+    0,  // E_OP_JF_SHIFT
+    0,  // E_OP_JF_VTR
+    0,  // E_OP_JF_MODE
+    0,  // E_OP_JF_TICK
+    0,  // E_OP_JF_VOX
+    0,  // E_OP_JF_NOTE
+    0,  // E_OP_JF_GOD
+    0,  // E_OP_JF_TUNE
+    0,  // E_OP_JF_QT
+    0,  // E_OP_TO_TR
+    0,  // E_OP_TO_TR_TOG
+    0,  // E_OP_TO_TR_PULSE
+    0,  // E_OP_TO_TR_TIME
+    0,  // E_OP_TO_TR_TIME_S
+    0,  // E_OP_TO_TR_TIME_M
+    0,  // E_OP_TO_TR_POL
+    0,  // E_OP_TO_KILL
+    0,  // E_OP_TO_TR_PULSE_DIV
+    0,  // E_OP_TO_TR_PULSE_MUTE
+    0,  // E_OP_TO_TR_M_MUL
+    0,  // E_OP_TO_M
+    0,  // E_OP_TO_M_S
+    0,  // E_OP_TO_M_M
+    0,  // E_OP_TO_M_BPM
+    0,  // E_OP_TO_M_ACT
+    0,  // E_OP_TO_M_SYNC
+    0,  // E_OP_TO_M_COUNT
+    0,  // E_OP_TO_TR_M
+    0,  // E_OP_TO_TR_M_S
+    0,  // E_OP_TO_TR_M_M
+    0,  // E_OP_TO_TR_M_BPM
+    0,  // E_OP_TO_TR_M_ACT
+    0,  // E_OP_TO_TR_M_SYNC
+    0,  // E_OP_TO_TR_WIDTH
+    0,  // E_OP_TO_TR_M_COUNT
+    0,  // E_OP_TO_CV
+    0,  // E_OP_TO_CV_SLEW
+    0,  // E_OP_TO_CV_SLEW_S
+    0,  // E_OP_TO_CV_SLEW_M
+    0,  // E_OP_TO_CV_SET
+    0,  // E_OP_TO_CV_OFF
+    0,  // E_OP_TO_CV_QT
+    0,  // E_OP_TO_CV_QT_SET
+    0,  // E_OP_TO_CV_N
+    0,  // E_OP_TO_CV_N_SET
+    0,  // E_OP_TO_CV_SCALE
+    0,  // E_OP_TO_CV_LOG
+    0,  // E_OP_TO_CV_INIT
+    0,  // E_OP_TO_TR_INIT
+    0,  // E_OP_TO_INIT
+    0,  // E_OP_TO_TR_P
+    0,  // E_OP_TO_TR_P_DIV
+    0,  // E_OP_TO_TR_P_MUTE
+    0,  // E_OP_TO_OSC
+    0,  // E_OP_TO_OSC_SET
+    0,  // E_OP_TO_OSC_QT
+    0,  // E_OP_TO_OSC_QT_SET
+    0,  // E_OP_TO_OSC_FQ
+    0,  // E_OP_TO_OSC_FQ_SET
+    0,  // E_OP_TO_OSC_N
+    0,  // E_OP_TO_OSC_N_SET
+    0,  // E_OP_TO_OSC_LFO
+    0,  // E_OP_TO_OSC_LFO_SET
+    0,  // E_OP_TO_OSC_WAVE
+    0,  // E_OP_TO_OSC_SYNC
+    0,  // E_OP_TO_OSC_PHASE
+    0,  // E_OP_TO_OSC_WIDTH
+    0,  // E_OP_TO_OSC_RECT
+    0,  // E_OP_TO_OSC_SLEW
+    0,  // E_OP_TO_OSC_SLEW_S
+    0,  // E_OP_TO_OSC_SLEW_M
+    0,  // E_OP_TO_OSC_SCALE
+    0,  // E_OP_TO_OSC_CYC
+    0,  // E_OP_TO_OSC_CYC_S
+    0,  // E_OP_TO_OSC_CYC_M
+    0,  // E_OP_TO_OSC_CYC_SET
+    0,  // E_OP_TO_OSC_CYC_S_SET
+    0,  // E_OP_TO_OSC_CYC_M_SET
+    0,  // E_OP_TO_OSC_CTR
+    0,  // E_OP_TO_ENV_ACT
+    0,  // E_OP_TO_ENV_ATT
+    0,  // E_OP_TO_ENV_ATT_S
+    0,  // E_OP_TO_ENV_ATT_M
+    0,  // E_OP_TO_ENV_DEC
+    0,  // E_OP_TO_ENV_DEC_S
+    0,  // E_OP_TO_ENV_DEC_M
+    0,  // E_OP_TO_ENV_TRIG
+    0,  // E_OP_TO_ENV_EOR
+    0,  // E_OP_TO_ENV_EOC
+    0,  // E_OP_TO_ENV_LOOP
+    OP_FLAG_RETURNS,  // E_OP_TI_PARAM
+    OP_FLAG_RETURNS,  // E_OP_TI_PARAM_QT
+    OP_FLAG_RETURNS,  // E_OP_TI_PARAM_N
+    0,  // E_OP_TI_PARAM_SCALE
+    0,  // E_OP_TI_PARAM_MAP
+    OP_FLAG_RETURNS,  // E_OP_TI_IN
+    OP_FLAG_RETURNS,  // E_OP_TI_IN_QT
+    OP_FLAG_RETURNS,  // E_OP_TI_IN_N
+    0,  // E_OP_TI_IN_SCALE
+    0,  // E_OP_TI_IN_MAP
+    0,  // E_OP_TI_PARAM_CALIB
+    0,  // E_OP_TI_IN_CALIB
+    0,  // E_OP_TI_STORE
+    0,  // E_OP_TI_RESET
+    0,  // E_OP_TI_PARAM_INIT
+    0,  // E_OP_TI_IN_INIT
+    0,  // E_OP_TI_INIT
+    OP_FLAG_RETURNS,  // E_OP_TI_PRM
+    OP_FLAG_RETURNS,  // E_OP_TI_PRM_QT
+    OP_FLAG_RETURNS,  // E_OP_TI_PRM_N
+    0,  // E_OP_TI_PRM_SCALE
+    0,  // E_OP_TI_PRM_MAP
+    0,  // E_OP_TI_PRM_INIT
+};
+
@@ -1,5 +1,7 @@
 #include "ops/patterns.h"
 
+#include <stdlib.h>  // rand
+
 #include "helpers.h"
 #include "teletype.h"
 #include "teletype_io.h"
@@ -53,6 +55,27 @@ static void op_P_N_set(const void *NOTUSED(data), scene_state_t *ss,
 const tele_op_t op_P_N = MAKE_GET_SET_OP(P.N, op_P_N_get, op_P_N_set, 0, true);
 
 
+////////////////////////////////////////////////////////////////////////////////
+// P.BANK //////////////////////////////////////////////////////////////////////
+
+static void op_P_BANK_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss_get_pattern_bank(ss));
+}
+
+static void op_P_BANK_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    if (a < 0) a = 0;
+    if (a >= PATTERN_BANK_COUNT) a = PATTERN_BANK_COUNT - 1;
+    ss_select_pattern_bank(ss, a);
+    tele_pattern_updated();
+}
+
+const tele_op_t op_P_BANK =
+    MAKE_GET_SET_OP(P.BANK, op_P_BANK_get, op_P_BANK_set, 0, true);
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // P and PN ////////////////////////////////////////////////////////////////////
 
@@ -658,3 +681,324 @@ static void op_PN_POP_get(const void *NOTUSED(data), scene_state_t *ss,
 // Make ops
 const tele_op_t op_P_POP = MAKE_GET_OP(P.POP, op_P_POP_get, 0, true);
 const tele_op_t op_PN_POP = MAKE_GET_OP(PN.POP, op_PN_POP_get, 1, true);
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Bulk ops ////////////////////////////////////////////////////////////////////
+
+// These work on the values from START to END (no further than L), in a single
+// loop over val, rather than needing a loop of P commands in a script
+
+// find the range of a pattern to work on, returns false if it's empty
+static bool p_range(scene_state_t *ss, int16_t pn, int16_t *first,
+                    int16_t *last) {
+    const int16_t len = ss_get_pattern_len(ss, pn);
+    int16_t start = ss_get_pattern_start(ss, pn);
+    int16_t end = ss_get_pattern_end(ss, pn);
+    if (start < 0) start = 0;
+    if (end >= len) end = len - 1;
+    if (end >= PATTERN_LENGTH) end = PATTERN_LENGTH - 1;
+    *first = start;
+    *last = end;
+    return start <= end;
+}
+
+static void p_reverse(int16_t *val, int16_t first, int16_t last) {
+    while (first < last) {
+        const int16_t v = val[first];
+        val[first++] = val[last];
+        val[last--] = v;
+    }
+}
+
+// P.REV
+static void p_rev_get(scene_state_t *ss, int16_t pn) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return;
+    p_reverse(ss_edit_pattern_vals(ss, pn), first, last);
+}
+
+static void op_P_REV_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es),
+                         command_state_t *NOTUSED(cs)) {
+    p_rev_get(ss, ss->variables.p_n);
+    tele_pattern_updated();
+}
+
+static void op_PN_REV_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    p_rev_get(ss, cs_pop(cs));
+    tele_pattern_updated();
+}
+
+// P.ROT, moves each value n places towards END, wrapping around to START,
+// done as 3 reversals so that it needs no extra storage
+static void p_rot_get(scene_state_t *ss, int16_t pn, int16_t n) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return;
+
+    const int16_t count = last - first + 1;
+    n %= count;
+    if (n < 0) n += count;
+    if (n == 0) return;
+
+    int16_t *val = ss_edit_pattern_vals(ss, pn);
+    p_reverse(val, first, last);
+    p_reverse(val, first, first + n - 1);
+    p_reverse(val, first + n, last);
+}
+
+static void op_P_ROT_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    p_rot_get(ss, ss->variables.p_n, a);
+    tele_pattern_updated();
+}
+
+static void op_PN_ROT_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t pn = cs_pop(cs);
+    int16_t a = cs_pop(cs);
+    p_rot_get(ss, pn, a);
+    tele_pattern_updated();
+}
+
+// P.SHUF, a Fisher-Yates shuffle
+static void p_shuf_get(scene_state_t *ss, int16_t pn) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return;
+
+    int16_t *val = ss_edit_pattern_vals(ss, pn);
+    for (int16_t i = last; i > first; i--) {
+        const int16_t j = first + rand() % (i - first + 1);
+        const int16_t v = val[i];
+        val[i] = val[j];
+        val[j] = v;
+    }
+}
+
+static void op_P_SHUF_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es),
+                          command_state_t *NOTUSED(cs)) {
+    p_shuf_get(ss, ss->variables.p_n);
+    tele_pattern_updated();
+}
+
+static void op_PN_SHUF_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    p_shuf_get(ss, cs_pop(cs));
+    tele_pattern_updated();
+}
+
+// P.SUM, limited to the range of a value
+static int16_t p_sum_get(scene_state_t *ss, int16_t pn) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return 0;
+
+    const int16_t *val = ss->patterns[pn].val;
+    int32_t sum = 0;
+    for (int16_t i = first; i <= last; i++) sum += val[i];
+
+    if (sum > INT16_MAX) return INT16_MAX;
+    if (sum < INT16_MIN) return INT16_MIN;
+    return sum;
+}
+
+static void op_P_SUM_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, p_sum_get(ss, ss->variables.p_n));
+}
+
+static void op_PN_SUM_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, p_sum_get(ss, cs_pop(cs)));
+}
+
+// P.MIN and P.MAX
+static int16_t p_min_max_get(scene_state_t *ss, int16_t pn, bool is_min) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return 0;
+
+    const int16_t *val = ss->patterns[pn].val;
+    int16_t out = val[first];
+    for (int16_t i = first + 1; i <= last; i++) {
+        if (is_min ? val[i] < out : val[i] > out) out = val[i];
+    }
+    return out;
+}
+
+static void op_P_MIN_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, p_min_max_get(ss, ss->variables.p_n, true));
+}
+
+static void op_PN_MIN_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, p_min_max_get(ss, cs_pop(cs), true));
+}
+
+static void op_P_MAX_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, p_min_max_get(ss, ss->variables.p_n, false));
+}
+
+static void op_PN_MAX_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, p_min_max_get(ss, cs_pop(cs), false));
+}
+
+// P.FIND, returns the index of the first value equal to x, or -1
+static int16_t p_find_get(scene_state_t *ss, int16_t pn, int16_t x) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return -1;
+
+    const int16_t *val = ss->patterns[pn].val;
+    for (int16_t i = first; i <= last; i++) {
+        if (val[i] == x) return i;
+    }
+    return -1;
+}
+
+static void op_P_FIND_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    cs_push(cs, p_find_get(ss, ss->variables.p_n, a));
+}
+
+static void op_PN_FIND_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t pn = cs_pop(cs);
+    int16_t a = cs_pop(cs);
+    cs_push(cs, p_find_get(ss, pn, a));
+}
+
+// P.ADD
+static void p_add_get(scene_state_t *ss, int16_t pn, int16_t x) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return;
+
+    int16_t *val = ss_edit_pattern_vals(ss, pn);
+    for (int16_t i = first; i <= last; i++) val[i] += x;
+}
+
+static void op_P_ADD_get(const void *NOTUSED(data), scene_state_t *ss,
+                         exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    p_add_get(ss, ss->variables.p_n, a);
+    tele_pattern_updated();
+}
+
+static void op_PN_ADD_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t pn = cs_pop(cs);
+    int16_t a = cs_pop(cs);
+    p_add_get(ss, pn, a);
+    tele_pattern_updated();
+}
+
+// P.SCALE, maps each value from a..b to x..y, as SCALE does
+static void p_scale_get(scene_state_t *ss, int16_t pn, int16_t a, int16_t b,
+                        int16_t x, int16_t y) {
+    int16_t first, last;
+    pn = normalise_pn(pn);
+    if (!p_range(ss, pn, &first, &last)) return;
+
+    int16_t *val = ss_edit_pattern_vals(ss, pn);
+    for (int16_t i = first; i <= last; i++) {
+        if ((b - a) == 0)
+            val[i] = 0;
+        else
+            val[i] = (val[i] - a) * (y - x) / (b - a) + x;
+    }
+}
+
+static void op_P_SCALE_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    int16_t x = cs_pop(cs);
+    int16_t y = cs_pop(cs);
+    p_scale_get(ss, ss->variables.p_n, a, b, x, y);
+    tele_pattern_updated();
+}
+
+static void op_PN_SCALE_get(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t pn = cs_pop(cs);
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    int16_t x = cs_pop(cs);
+    int16_t y = cs_pop(cs);
+    p_scale_get(ss, pn, a, b, x, y);
+    tele_pattern_updated();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Loops ///////////////////////////////////////////////////////////////////////
+
+// runs an L from `from` to `to` that has been compiled to I_PATTERN_LOOP (see
+// loop idioms in bytecode.c), it must leave the scene exactly as interpreting
+// the post command on each pass would, including the final value of I
+void p_loop(scene_state_t *ss, exec_state_t *es, const pattern_loop_t *loop,
+            int16_t from, int16_t to) {
+    const int16_t dst = loop->dst == -1 ? ss->variables.p_n : loop->dst;
+    const int16_t src = loop->src == -1 ? ss->variables.p_n : loop->src;
+    const int16_t step = from <= to ? 1 : -1;
+
+    // the post command can't set a variable, so it only needs reading once
+    int16_t value = loop->value;
+    if (loop->value_type == LOOP_VALUE_VARIABLE)
+        value = *(int16_t *)((char *)ss + loop->value);
+
+    for (int16_t i = from;; i += step) {
+        int16_t v = value;
+        if (loop->value_type == LOOP_VALUE_I) { v = i + loop->value; }
+        else if (loop->value_type == LOOP_VALUE_PATTERN) {
+            v = p_get(ss, src, i + loop->value);
+        }
+        else if (loop->value_type == LOOP_VALUE_OP) {
+            const tele_op_t *op = tele_ops[loop->value];
+            command_state_t cs;
+            cs_init(&cs);
+            for (uint8_t a = 0; a < loop->params; a++)
+                cs_push(&cs, loop->args[a]);
+            op->get(op->data, ss, es, &cs);
+            v = cs_pop(&cs);
+        }
+
+        p_set(ss, dst, i + loop->dst_offset, v);
+        if (i == to) break;
+    }
+
+    ss->variables.i = to;
+    tele_pattern_updated();
+}
+
+// Make ops
+// clang-format off
+const tele_op_t op_P_REV    = MAKE_GET_OP(P.REV   , op_P_REV_get   , 0, false);
+const tele_op_t op_PN_REV   = MAKE_GET_OP(PN.REV  , op_PN_REV_get  , 1, false);
+const tele_op_t op_P_ROT    = MAKE_GET_OP(P.ROT   , op_P_ROT_get   , 1, false);
+const tele_op_t op_PN_ROT   = MAKE_GET_OP(PN.ROT  , op_PN_ROT_get  , 2, false);
+const tele_op_t op_P_SHUF   = MAKE_GET_OP(P.SHUF  , op_P_SHUF_get  , 0, false);
+const tele_op_t op_PN_SHUF  = MAKE_GET_OP(PN.SHUF , op_PN_SHUF_get , 1, false);
+const tele_op_t op_P_SUM    = MAKE_GET_OP(P.SUM   , op_P_SUM_get   , 0, true);
+const tele_op_t op_PN_SUM   = MAKE_GET_OP(PN.SUM  , op_PN_SUM_get  , 1, true);
+const tele_op_t op_P_MIN    = MAKE_GET_OP(P.MIN   , op_P_MIN_get   , 0, true);
+const tele_op_t op_PN_MIN   = MAKE_GET_OP(PN.MIN  , op_PN_MIN_get  , 1, true);
+const tele_op_t op_P_MAX    = MAKE_GET_OP(P.MAX   , op_P_MAX_get   , 0, true);
+const tele_op_t op_PN_MAX   = MAKE_GET_OP(PN.MAX  , op_PN_MAX_get  , 1, true);
+const tele_op_t op_P_FIND   = MAKE_GET_OP(P.FIND  , op_P_FIND_get  , 1, true);
+const tele_op_t op_PN_FIND  = MAKE_GET_OP(PN.FIND , op_PN_FIND_get , 2, true);
+const tele_op_t op_P_ADD    = MAKE_GET_OP(P.ADD   , op_P_ADD_get   , 1, false);
+const tele_op_t op_PN_ADD   = MAKE_GET_OP(PN.ADD  , op_PN_ADD_get  , 2, false);
+const tele_op_t op_P_SCALE  = MAKE_GET_OP(P.SCALE , op_P_SCALE_get , 4, false);
+const tele_op_t op_PN_SCALE = MAKE_GET_OP(PN.SCALE, op_PN_SCALE_get, 5, false);
+// clang-format on
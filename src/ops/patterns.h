@@ -4,6 +4,7 @@
 #include "ops/op.h"
 
 extern const tele_op_t op_P_N;
+extern const tele_op_t op_P_BANK;
 extern const tele_op_t op_P;
 extern const tele_op_t op_PN;
 extern const tele_op_t op_P_L;
@@ -32,4 +33,26 @@ extern const tele_op_t op_PN_PUSH;
 extern const tele_op_t op_P_POP;
 extern const tele_op_t op_PN_POP;
 
+extern const tele_op_t op_P_REV;
+extern const tele_op_t op_PN_REV;
+extern const tele_op_t op_P_ROT;
+extern const tele_op_t op_PN_ROT;
+extern const tele_op_t op_P_SHUF;
+extern const tele_op_t op_PN_SHUF;
+extern const tele_op_t op_P_SUM;
+extern const tele_op_t op_PN_SUM;
+extern const tele_op_t op_P_MIN;
+extern const tele_op_t op_PN_MIN;
+extern const tele_op_t op_P_MAX;
+extern const tele_op_t op_PN_MAX;
+extern const tele_op_t op_P_FIND;
+extern const tele_op_t op_PN_FIND;
+extern const tele_op_t op_P_ADD;
+extern const tele_op_t op_PN_ADD;
+extern const tele_op_t op_P_SCALE;
+extern const tele_op_t op_PN_SCALE;
+
+void p_loop(scene_state_t *ss, exec_state_t *es, const pattern_loop_t *loop,
+            int16_t from, int16_t to);
+
 #endif
@@ -133,9 +133,7 @@ extern const tele_op_t op_TI_PRM_INIT;
 void TXSend(uint8_t model, uint8_t command, uint8_t output, int16_t value,
             bool set);
 void TXCmd(uint8_t model, uint8_t command, uint8_t output);
-void TXSet(uint8_t model, uint8_t command, command_state_t *cs);
-void TXDeviceSet(uint8_t model, uint8_t command, command_state_t *cs);
-void TXReceive(uint8_t model, command_state_t *cs, uint8_t mode, bool shift);
+void TXReceive(uint8_t model, command_state_t *cs, uint8_t command);
 uint8_t DeviceToOutput(int16_t device);
 // temporary init functions
 void INInit(uint8_t input);
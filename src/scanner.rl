@@ -32,8 +32,7 @@ error_t scanner(const char *data, tele_command_t *out,
 
     // reset outputs
     error_msg[0] = 0;
-    out->length = 0;
-    out->separator = -1;
+    command_init(out);
 
     %%{
         separator = [ \n\t];
@@ -58,11 +57,14 @@ error_t scanner(const char *data, tele_command_t *out,
 
             tele_data_t tele_data;
             if (match_token(buf, len, &tele_data)) {
-                // if we have a match, copy data to the the command
-                out->data[out->length] = tele_data;
-
-                // increase the command length
-                out->length++;
+                // if we have a match, copy data to the the command (the
+                // length is checked below, so this can only fail if there are
+                // more wide numbers than any valid command has, see
+                // COMMAND_MAX_WIDE)
+                if (!command_append(out, tele_data.tag, tele_data.value)) {
+                    strcpy(error_msg, buf);
+                    return E_EXTRA_PARAMS;
+                }
 
                 // if the command length is now too long, abort
                 if (out->length >= COMMAND_MAX_LENGTH) return E_LENGTH;
@@ -79,12 +81,8 @@ error_t scanner(const char *data, tele_command_t *out,
 
             // it's a PRE_SEP, we need to record it's position
             // (validate checks for too many PRE_SEP tokens)
-            out->data[out->length].tag = PRE_SEP;
-            out->data[out->length].value = 0;
             out->separator = out->length;
-
-            // increase the command length
-            out->length++;
+            command_append(out, PRE_SEP, 0);
 
             // if the command length is now too long, abort
             if (out->length >= COMMAND_MAX_LENGTH) return E_LENGTH;
@@ -92,11 +90,7 @@ error_t scanner(const char *data, tele_command_t *out,
 
         action sub_separator {
             // ':' mod separator matched
-            out->data[out->length].tag = SUB_SEP;
-            out->data[out->length].value = 0;
-
-            // increase the command length
-            out->length++;
+            command_append(out, SUB_SEP, 0);
 
             // if the command length is now too long, abort
             if (out->length >= COMMAND_MAX_LENGTH) return E_LENGTH;
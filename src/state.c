@@ -13,10 +13,15 @@
 void ss_init(scene_state_t *ss) {
     ss_variables_init(ss);
     ss_patterns_init(ss);
-    ss->delay.count = 0;
+    ss_queue_init(ss);
+    ss_delays_init(ss);
     for (size_t i = 0; i < TR_COUNT; i++) { ss->tr_pulse_timer[i] = 0; }
+    ss->time_ticks = 0;
+    ss_metros_init(ss);
     ss->stack_op.top = 0;
     memset(&ss->scripts, 0, ss_scripts_size());
+    memset(&ss->bytecode, 0, sizeof(ss->bytecode));
+    memset(&ss->inlined, 0, sizeof(ss->inlined));
 }
 
 void ss_variables_init(scene_state_t *ss) {
@@ -29,13 +34,10 @@ void ss_variables_init(scene_state_t *ss) {
         .d = 4,
         .drunk_min = 0,
         .drunk_max = 255,
-        .m = 1000,
-        .m_act = 1,
         .o_inc = 1,
         .o_min = 0,
         .o_max = 63,
         .o_wrap = 1,
-        .q_n = 1,
         .time_act = 1,
         .tr_pol = { 1, 1, 1, 1 },
         .tr_time = { 100, 100, 100, 100 }
@@ -45,13 +47,11 @@ void ss_variables_init(scene_state_t *ss) {
 }
 
 void ss_patterns_init(scene_state_t *ss) {
-    for (size_t i = 0; i < PATTERN_COUNT; i++) { ss_pattern_init(ss, i); }
+    ss_pattern_bank_init(ss->patterns);
+    ss_set_pattern_bank(ss, 0);
 }
 
-void ss_pattern_init(scene_state_t *ss, size_t pattern_no) {
-    if (pattern_no >= PATTERN_COUNT) return;
-
-    scene_pattern_t *p = &ss->patterns[pattern_no];
+static void pattern_init(scene_pattern_t *p) {
     p->idx = 0;
     p->len = 0;
     p->wrap = 1;
@@ -60,6 +60,12 @@ void ss_pattern_init(scene_state_t *ss, size_t pattern_no) {
     for (size_t i = 0; i < PATTERN_LENGTH; i++) { p->val[i] = 0; }
 }
 
+void ss_pattern_init(scene_state_t *ss, size_t pattern_no) {
+    if (pattern_no >= PATTERN_COUNT) return;
+    pattern_init(&ss->patterns[pattern_no]);
+    ss->pattern_bank_changed = true;
+}
+
 // external variable setting
 
 void ss_set_in(scene_state_t *ss, int16_t value) {
@@ -93,6 +99,7 @@ int16_t ss_get_pattern_idx(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_idx(scene_state_t *ss, size_t pattern, int16_t i) {
     ss->patterns[pattern].idx = i;
+    ss->pattern_bank_changed = true;
 }
 
 int16_t ss_get_pattern_len(scene_state_t *ss, size_t pattern) {
@@ -101,6 +108,7 @@ int16_t ss_get_pattern_len(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_len(scene_state_t *ss, size_t pattern, int16_t l) {
     ss->patterns[pattern].len = l;
+    ss->pattern_bank_changed = true;
 }
 
 uint16_t ss_get_pattern_wrap(scene_state_t *ss, size_t pattern) {
@@ -109,6 +117,7 @@ uint16_t ss_get_pattern_wrap(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_wrap(scene_state_t *ss, size_t pattern, uint16_t wrap) {
     ss->patterns[pattern].wrap = wrap;
+    ss->pattern_bank_changed = true;
 }
 
 int16_t ss_get_pattern_start(scene_state_t *ss, size_t pattern) {
@@ -117,6 +126,7 @@ int16_t ss_get_pattern_start(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_start(scene_state_t *ss, size_t pattern, int16_t start) {
     ss->patterns[pattern].start = start;
+    ss->pattern_bank_changed = true;
 }
 
 int16_t ss_get_pattern_end(scene_state_t *ss, size_t pattern) {
@@ -125,6 +135,7 @@ int16_t ss_get_pattern_end(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_end(scene_state_t *ss, size_t pattern, int16_t end) {
     ss->patterns[pattern].end = end;
+    ss->pattern_bank_changed = true;
 }
 
 int16_t ss_get_pattern_val(scene_state_t *ss, size_t pattern, size_t idx) {
@@ -134,6 +145,13 @@ int16_t ss_get_pattern_val(scene_state_t *ss, size_t pattern, size_t idx) {
 void ss_set_pattern_val(scene_state_t *ss, size_t pattern, size_t idx,
                         int16_t val) {
     ss->patterns[pattern].val[idx] = val;
+    ss->pattern_bank_changed = true;
+}
+
+// for ops that change many values at once
+int16_t *ss_edit_pattern_vals(scene_state_t *ss, size_t pattern) {
+    ss->pattern_bank_changed = true;
+    return ss->patterns[pattern].val;
 }
 
 scene_pattern_t *ss_patterns_ptr(scene_state_t *ss) {
@@ -144,6 +162,326 @@ size_t ss_patterns_size() {
     return sizeof(scene_pattern_t) * PATTERN_COUNT;
 }
 
+// pattern banks
+
+// fill a bank of PATTERN_COUNT patterns with empty ones, for targets to
+// initialise the banks they keep
+void ss_pattern_bank_init(scene_pattern_t *patterns) {
+    for (size_t i = 0; i < PATTERN_COUNT; i++) { pattern_init(&patterns[i]); }
+}
+
+uint8_t ss_get_pattern_bank(scene_state_t *ss) {
+    return ss->pattern_bank;
+}
+
+// to be called once the patterns of bank have been copied in directly (e.g.
+// from flash when a scene is loaded)
+void ss_set_pattern_bank(scene_state_t *ss, uint8_t bank) {
+    ss->pattern_bank = bank;
+    ss->pattern_bank_changed = false;
+}
+
+// swap bank in for the selected one, writing the selected one back first if
+// it has been changed
+void ss_select_pattern_bank(scene_state_t *ss, uint8_t bank) {
+    if (bank >= PATTERN_BANK_COUNT || bank == ss->pattern_bank) return;
+    ss_write_back_pattern_bank(ss);
+    tele_pattern_bank_read(bank, ss->patterns);
+    ss_set_pattern_bank(ss, bank);
+}
+
+void ss_write_back_pattern_bank(scene_state_t *ss) {
+    if (!ss->pattern_bank_changed) return;
+    tele_pattern_bank_write(ss->pattern_bank, ss->patterns);
+    ss->pattern_bank_changed = false;
+}
+
+// queue
+
+#define Q_MASK (Q_LENGTH - 1)
+
+static int16_t queue_value(scene_queue_t *q, uint16_t seq) {
+    return q->values[seq & Q_MASK];
+}
+
+// private
+// add seq to the back of a deque, first removing any values that it replaces
+// as the min (or max), i.e. those that are greater (or less) than it
+static void queue_deque_push(scene_queue_t *q, uint16_t *deque, uint8_t head,
+                             uint8_t *count, uint16_t seq, bool is_min) {
+    const int16_t value = queue_value(q, seq);
+    while (*count) {
+        const uint16_t back_seq = deque[(head + *count - 1) & Q_MASK];
+        const int16_t back = queue_value(q, back_seq);
+        if (is_min ? back < value : back > value) break;
+        (*count)--;
+    }
+    deque[(head + *count) & Q_MASK] = seq;
+    (*count)++;
+}
+
+// private
+// recalculate the sum, min and max of the window from scratch
+static void queue_rebuild(scene_queue_t *q) {
+    q->sum = 0;
+    q->min_head = q->min_count = 0;
+    q->max_head = q->max_count = 0;
+    for (uint16_t seq = q->seq - q->len; seq != q->seq; seq++) {
+        q->sum += queue_value(q, seq);
+        queue_deque_push(q, q->min, q->min_head, &q->min_count, seq, true);
+        queue_deque_push(q, q->max, q->max_head, &q->max_count, seq, false);
+    }
+}
+
+void ss_queue_init(scene_state_t *ss) {
+    scene_queue_t *q = &ss->queue;
+    memset(q->values, 0, sizeof(q->values));
+    q->seq = 0;
+    q->len = 1;
+    queue_rebuild(q);
+}
+
+void ss_queue_push(scene_state_t *ss, int16_t value) {
+    scene_queue_t *q = &ss->queue;
+
+    // the oldest value leaves the window, as it is the oldest it can only be
+    // at the front of the deques
+    const uint16_t oldest = q->seq - q->len;
+    q->sum -= queue_value(q, oldest);
+    if (q->min[q->min_head] == oldest) {
+        q->min_head = (q->min_head + 1) & Q_MASK;
+        q->min_count--;
+    }
+    if (q->max[q->max_head] == oldest) {
+        q->max_head = (q->max_head + 1) & Q_MASK;
+        q->max_count--;
+    }
+
+    q->values[q->seq & Q_MASK] = value;
+    q->sum += value;
+    queue_deque_push(q, q->min, q->min_head, &q->min_count, q->seq, true);
+    queue_deque_push(q, q->max, q->max_head, &q->max_count, q->seq, false);
+    q->seq++;
+}
+
+int16_t ss_queue_get(scene_state_t *ss, uint8_t age) {
+    return queue_value(&ss->queue, ss->queue.seq - 1 - age);
+}
+
+void ss_queue_set_len(scene_state_t *ss, uint8_t len) {
+    if (len < 1) len = 1;
+    if (len > Q_LENGTH) len = Q_LENGTH;
+    ss->queue.len = len;
+    queue_rebuild(&ss->queue);
+}
+
+void ss_queue_fill(scene_state_t *ss, int16_t value) {
+    for (uint8_t i = 0; i < Q_LENGTH; i++) ss->queue.values[i] = value;
+    queue_rebuild(&ss->queue);
+}
+
+int16_t ss_queue_avg(scene_state_t *ss) {
+    return ss->queue.len ? ss->queue.sum / ss->queue.len : 0;
+}
+
+int16_t ss_queue_min(scene_state_t *ss) {
+    return queue_value(&ss->queue, ss->queue.min[ss->queue.min_head]);
+}
+
+int16_t ss_queue_max(scene_state_t *ss) {
+    return queue_value(&ss->queue, ss->queue.max[ss->queue.max_head]);
+}
+
+// metro
+
+void ss_metros_init(scene_state_t *ss) {
+    // only M is active to start with, M1 to M4 run scripts 1 to 4
+    for (size_t i = 0; i < METRO_COUNT; i++) {
+        scene_metro_t *metro = &ss->metros[i];
+        metro->m = 1000;
+        metro->act = i == 0;
+        metro->script = i == 0 ? METRO_SCRIPT : i - 1;
+        metro->load = 0;
+        ss_reset_metro(ss, i);
+    }
+    ss->metro_late = 0;
+    ss->metro_missed = 0;
+    ss->metro_policy = METRO_SKIP;
+}
+
+uint32_t ss_get_metro_period(scene_state_t *ss, size_t i) {
+    int16_t m = ss->metros[i].m;
+    if (m < METRO_MIN_UNSUPPORTED_MS) m = METRO_MIN_UNSUPPORTED_MS;
+    return (uint32_t)m * TICKS_PER_MS;
+}
+
+void ss_reset_metro(scene_state_t *ss, size_t i) {
+    ss->metros[i].timer = ss_get_metro_period(ss, i);
+}
+
+uint8_t ss_get_metro_load(scene_state_t *ss) {
+    uint16_t load = 0;
+    for (size_t i = 0; i < METRO_COUNT; i++)
+        if (ss->metros[i].act) load += ss->metros[i].load;
+    return load > UINT8_MAX ? UINT8_MAX : load;
+}
+
+// delays
+
+static uint8_t delay_slot(uint32_t time) {
+    return (time >> DELAY_WHEEL_SHIFT) & (DELAY_WHEEL_SIZE - 1);
+}
+
+// is time a before time b (allowing for now wrapping around)
+static bool delay_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static bool delay_command_matches(const tele_bytecode_t *bc,
+                                  const tele_command_view_t *view) {
+    if (bc->length != view->end - view->start) return false;
+    for (uint8_t i = 0; i < bc->length; i++) {
+        const tele_instr_t *instr = &view->bytecode->data[view->start + i];
+        if (bc->data[i].tag != instr->tag || bc->data[i].value != instr->value)
+            return false;
+    }
+    return true;
+}
+
+void ss_delays_init(scene_state_t *ss) {
+    scene_delay_t *d = &ss->delay;
+
+    for (uint8_t i = 0; i < DELAY_SIZE; i++)
+        d->entries[i].next = i + 1 < DELAY_SIZE ? i + 1 : DELAY_NONE;
+    d->free_entry = 0;
+
+    for (uint8_t i = 0; i < DELAY_COMMANDS; i++) {
+        d->commands[i].refs = 0;
+        d->free_commands[i] = i;
+    }
+    d->free_command_count = DELAY_COMMANDS;
+    d->last_command = DELAY_NONE;
+
+    memset(d->wheel_head, DELAY_NONE, sizeof(d->wheel_head));
+    memset(d->wheel_tail, DELAY_NONE, sizeof(d->wheel_tail));
+    d->count = 0;
+    d->now = 0;
+    d->next_due = 0;
+}
+
+bool ss_add_delay(scene_state_t *ss, uint32_t time,
+                  const tele_command_view_t *command) {
+    scene_delay_t *d = &ss->delay;
+    if (d->free_entry == DELAY_NONE) return false;
+
+    // share the command with the previous delay if we can
+    uint8_t c = d->last_command;
+    if (c == DELAY_NONE || d->commands[c].refs == 0 ||
+        !delay_command_matches(&d->commands[c].bytecode, command)) {
+        if (d->free_command_count == 0) return false;
+        c = d->free_commands[--d->free_command_count];
+        copy_command_view(&d->commands[c].bytecode, command);
+        d->last_command = c;
+    }
+    d->commands[c].refs++;
+
+    const uint8_t e = d->free_entry;
+    scene_delay_entry_t *entry = &d->entries[e];
+    d->free_entry = entry->next;
+    entry->due = d->now + time;
+    entry->command = c;
+    entry->next = DELAY_NONE;
+
+    // append, so that delays due at the same time run in the order they were
+    // added
+    const uint8_t slot = delay_slot(entry->due);
+    if (d->wheel_tail[slot] == DELAY_NONE)
+        d->wheel_head[slot] = e;
+    else
+        d->entries[d->wheel_tail[slot]].next = e;
+    d->wheel_tail[slot] = e;
+
+    if (d->count == 0 || delay_before(entry->due, d->next_due))
+        d->next_due = entry->due;
+    d->count++;
+
+    return true;
+}
+
+void ss_advance_delays(scene_state_t *ss, uint32_t time) {
+    ss->delay.now += time;
+}
+
+uint32_t ss_next_delay(scene_state_t *ss) {
+    // next_due is exact whenever delays aren't being run
+    const scene_delay_t *d = &ss->delay;
+    return delay_before(d->now, d->next_due) ? d->next_due - d->now : 0;
+}
+
+// private
+static void delay_remove(scene_delay_t *d, uint8_t slot, uint8_t prev,
+                         uint8_t e) {
+    scene_delay_entry_t *entry = &d->entries[e];
+
+    if (prev == DELAY_NONE)
+        d->wheel_head[slot] = entry->next;
+    else
+        d->entries[prev].next = entry->next;
+    if (d->wheel_tail[slot] == e) d->wheel_tail[slot] = prev;
+
+    d->commands[entry->command].refs--;
+    if (d->commands[entry->command].refs == 0)
+        d->free_commands[d->free_command_count++] = entry->command;
+
+    entry->next = d->free_entry;
+    d->free_entry = e;
+    d->count--;
+}
+
+// private
+// find the earliest delay, only called once all those that are due have run
+static void delay_update_next_due(scene_delay_t *d) {
+    bool found = false;
+    for (uint8_t slot = 0; slot < DELAY_WHEEL_SIZE; slot++) {
+        for (uint8_t e = d->wheel_head[slot]; e != DELAY_NONE;
+             e = d->entries[e].next) {
+            if (!found || delay_before(d->entries[e].due, d->next_due)) {
+                d->next_due = d->entries[e].due;
+                found = true;
+            }
+        }
+    }
+}
+
+bool ss_take_due_delay(scene_state_t *ss, tele_bytecode_t *out) {
+    scene_delay_t *d = &ss->delay;
+    if (d->count == 0 || delay_before(d->now, d->next_due)) return false;
+
+    // everything due is in the slots from next_due up to now
+    uint32_t slots = ((d->now - d->next_due) >> DELAY_WHEEL_SHIFT) + 1;
+    if (slots > DELAY_WHEEL_SIZE) slots = DELAY_WHEEL_SIZE;
+
+    for (uint8_t i = 0; i < slots; i++) {
+        const uint8_t slot =
+            (delay_slot(d->next_due) + i) & (DELAY_WHEEL_SIZE - 1);
+        uint8_t prev = DELAY_NONE;
+        for (uint8_t e = d->wheel_head[slot]; e != DELAY_NONE;
+             prev = e, e = d->entries[e].next) {
+            if (delay_before(d->now, d->entries[e].due)) continue;
+
+            // copy the command out before it's freed, as running it could
+            // add delays
+            memcpy(out, &d->commands[d->entries[e].command].bytecode,
+                   sizeof(tele_bytecode_t));
+            delay_remove(d, slot, prev, e);
+            return true;
+        }
+    }
+
+    delay_update_next_due(d);
+    return false;
+}
+
 // script manipulation
 
 uint8_t ss_get_script_len(scene_state_t *ss, size_t idx) {
@@ -160,10 +498,88 @@ const tele_command_t *ss_get_script_command(scene_state_t *ss,
     return &ss->scripts[script_idx].c[c_idx];
 }
 
+const tele_bytecode_t *ss_get_script_bytecode(scene_state_t *ss,
+                                              size_t script_idx, size_t c_idx) {
+    return &ss->bytecode[script_idx][c_idx];
+}
+
+uint8_t ss_get_inlined_script_len(scene_state_t *ss, size_t idx) {
+    return ss->inlined[idx].l;
+}
+
+const tele_bytecode_t *ss_get_inlined_script_bytecode(scene_state_t *ss,
+                                                      size_t script_idx,
+                                                      size_t idx) {
+    const scene_script_line_t *line = &ss->inlined[script_idx].lines[idx];
+    return &ss->bytecode[line->script][line->line];
+}
+
+// private
+// is the command just a call to another script with a literal value? if so
+// return the script it calls
+static bool ss_is_script_call(const tele_bytecode_t *bc, uint8_t *script) {
+    if (bc->length != 2 || bc->data[0].tag != I_NUMBER ||
+        bc->data[1].tag != I_SCRIPT)
+        return false;
+
+    // must match op_SCRIPT_get
+    uint16_t a = bc->data[0].value - 1;
+    if (a >= SCRIPT_COUNT || a == INIT_SCRIPT || a == METRO_SCRIPT)
+        return false;
+
+    *script = a;
+    return true;
+}
+
+// private
+// append the lines of a script to out, inlining the scripts it calls (unless
+// they're already being inlined, i.e. recursive calls). Returns false if out
+// would need more than limit lines.
+static bool ss_inline_script(scene_state_t *ss, size_t script_idx,
+                             uint16_t inlining, uint8_t limit,
+                             scene_inlined_script_t *out) {
+    const uint8_t len = ss_get_script_len(ss, script_idx);
+
+    for (uint8_t i = 0; i < len; i++) {
+        uint8_t callee;
+        if (ss_is_script_call(&ss->bytecode[script_idx][i], &callee) &&
+            !(inlining & (1 << callee))) {
+            // leave enough room for the rest of our lines, if the callee
+            // doesn't fit it's called at run time instead
+            const uint8_t start = out->l;
+            const uint8_t remaining = len - i - 1;
+            if (limit > remaining &&
+                ss_inline_script(ss, callee, inlining | (1 << callee),
+                                 limit - remaining, out))
+                continue;
+            out->l = start;
+        }
+
+        if (out->l >= limit) return false;
+        out->lines[out->l].script = script_idx;
+        out->lines[out->l].line = i;
+        out->l++;
+    }
+
+    return true;
+}
+
+// private
+// needs to be called whenever any script changes, as the change could affect
+// any script that calls it
+static void ss_inline_scripts(scene_state_t *ss) {
+    for (size_t i = 0; i < SCRIPT_COUNT; i++) {
+        ss->inlined[i].l = 0;
+        ss_inline_script(ss, i, 1 << i, SCRIPT_MAX_INLINED_COMMANDS,
+                         &ss->inlined[i]);
+    }
+}
+
 // private
 static void ss_set_script_command(scene_state_t *ss, size_t script_idx,
                                   size_t c_idx, const tele_command_t *cmd) {
     memcpy(&ss->scripts[script_idx].c[c_idx], cmd, sizeof(tele_command_t));
+    compile_command(cmd, &ss->bytecode[script_idx][c_idx]);
 }
 
 void ss_overwrite_script_command(scene_state_t *ss, size_t script_idx,
@@ -178,6 +594,8 @@ void ss_overwrite_script_command(scene_state_t *ss, size_t script_idx,
     if (script_len < SCRIPT_MAX_COMMANDS && command_idx >= script_len) {
         ss_set_script_len(ss, script_idx, script_len + 1);
     }
+
+    ss_inline_scripts(ss);
 }
 
 void ss_insert_script_command(scene_state_t *ss, size_t script_idx,
@@ -222,8 +640,26 @@ void ss_delete_script_command(scene_state_t *ss, size_t script_idx,
 
         tele_command_t blank_command;
         blank_command.length = 0;
+        blank_command.separator = -1;
         ss_set_script_command(ss, script_idx, script_len, &blank_command);
+
+        ss_inline_scripts(ss);
+    }
+}
+
+// call after the scripts have been written to directly (e.g. via
+// ss_scripts_ptr)
+void ss_compile_scripts(scene_state_t *ss) {
+    for (size_t i = 0; i < SCRIPT_COUNT; i++) {
+        for (size_t j = 0; j < SCRIPT_MAX_COMMANDS; j++) {
+            if (j < ss_get_script_len(ss, i))
+                compile_command(&ss->scripts[i].c[j], &ss->bytecode[i][j]);
+            else
+                ss->bytecode[i][j].length = 0;
+        }
     }
+
+    ss_inline_scripts(ss);
 }
 
 scene_script_t *ss_scripts_ptr(scene_state_t *ss) {
@@ -243,6 +679,27 @@ void es_init(exec_state_t *es) {
     es->exec_depth = 0;
 }
 
+// a MOD is always run by the command in the top frame
+void es_run_post_command(exec_state_t *es,
+                         const tele_command_view_t *post_command) {
+    es_loop_post_command(es, post_command, 0, 0);
+}
+
+void es_loop_post_command(exec_state_t *es,
+                          const tele_command_view_t *post_command,
+                          int16_t from, int16_t to) {
+    // nothing to do if we're not being run by the executor (e.g. in tests)
+    if (es->exec_depth == 0) return;
+
+    exec_frame_t *frame = &es->frames[es->exec_depth - 1];
+    frame->ip = post_command->start;
+    frame->end = post_command->end;
+    frame->in_post = true;
+    frame->loop_i = from;
+    frame->loop_to = to;
+    cs_init(&frame->cs);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // COMMAND STATE ///////////////////////////////////////////////////////////////
@@ -5,25 +5,37 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "bytecode.h"
 #include "command.h"
 
 #define STACK_SIZE 8
+#define EXEC_DEPTH 8
 #define CV_COUNT 4
-#define Q_LENGTH 16
+#define Q_LENGTH 64  // must be a power of 2
 #define TR_COUNT 4
 #define TRIGGER_INPUTS 8
-#define DELAY_SIZE 8
+#define DELAY_SIZE 64
+#define DELAY_COMMANDS 16
+#define DELAY_WHEEL_SIZE 16
+#define DELAY_WHEEL_SHIFT 7  // each slot of the wheel covers 128 ticks
 #define STACK_OP_SIZE 8
 #define PATTERN_COUNT 4
 #define PATTERN_LENGTH 64
+#define PATTERN_BANK_COUNT 4
 #define SCRIPT_MAX_COMMANDS 6
 #define SCRIPT_COUNT 10
+#define SCRIPT_MAX_INLINED_COMMANDS 24
+
+// time is kept in ticks of 100 us, so that delays and TR pulses aren't
+// quantised to the rate that tele_tick is called at, ops still use ms
+#define TICKS_PER_MS 10
 
 #define METRO_SCRIPT 8
 #define INIT_SCRIPT 9
 
 #define METRO_MIN_MS 25
 #define METRO_MIN_UNSUPPORTED_MS 2
+#define METRO_COUNT 5  // M, and M1 to M4
 
 ////////////////////////////////////////////////////////////////////////////////
 // SCENE STATE /////////////////////////////////////////////////////////////////
@@ -44,8 +56,6 @@ typedef struct {
     int16_t flip;
     int16_t i;
     int16_t in;
-    int16_t m;
-    bool m_act;
     bool mutes[TRIGGER_INPUTS];
     int16_t o;
     int16_t o_inc;
@@ -54,8 +64,6 @@ typedef struct {
     int16_t o_wrap;
     int16_t p_n;
     int16_t param;
-    int16_t q[Q_LENGTH];
-    int16_t q_n;
     int16_t scene;
     int16_t t;
     int16_t time;
@@ -77,14 +85,81 @@ typedef struct {
     int16_t val[PATTERN_LENGTH];
 } scene_pattern_t;
 
+// Q keeps the last Q_LENGTH values in a ring buffer, indexed by the number of
+// values pushed before each one (its seq, which wraps around). The sum, min
+// and max of the newest len values (the ones that Q.AVG, Q.MIN and Q.MAX look
+// at) are kept up to date as values are pushed. The min and max are found
+// with monotonic deques of seqs, each value in the min deque is less than all
+// those after it (and greater for max), so the front is the min of the window.
+typedef struct {
+    int16_t values[Q_LENGTH];
+    uint16_t seq;  // of the next value to be pushed
+    uint8_t len;   // Q.N
+    int32_t sum;
+    uint16_t min[Q_LENGTH];  // a ring buffer of seqs
+    uint16_t max[Q_LENGTH];
+    uint8_t min_head;
+    uint8_t min_count;
+    uint8_t max_head;
+    uint8_t max_count;
+} scene_queue_t;
+
+// Delays are kept in a hashed timing wheel, each one goes into the slot for
+// its due time (whichever lap of the wheel that is in), so adding a delay
+// never has to search. next_due is never later than the earliest delay, so a
+// tick with nothing due doesn't need to look at the wheel at all.
+//
+// The delayed commands are stored separately from the delays, and a command
+// that is the same as the previous one (e.g. from DEL in a loop) is shared.
+
+#define DELAY_NONE 0xFF
+
+typedef struct {
+    uint32_t due;     // compared with scene_delay_t.now
+    uint8_t command;  // index into scene_delay_t.commands
+    uint8_t next;     // the next delay in the same slot, or the free list
+} scene_delay_entry_t;
+
+typedef struct {
+    tele_bytecode_t bytecode;
+    uint8_t refs;  // the number of delays using this command
+} scene_delay_command_t;
+
 typedef struct {
-    tele_command_t commands[DELAY_SIZE];
-    int16_t time[DELAY_SIZE];
+    scene_delay_entry_t entries[DELAY_SIZE];
+    scene_delay_command_t commands[DELAY_COMMANDS];
+    uint8_t wheel_head[DELAY_WHEEL_SIZE];
+    uint8_t wheel_tail[DELAY_WHEEL_SIZE];
+    uint8_t free_entry;
+    uint8_t free_commands[DELAY_COMMANDS];  // a stack of unused commands
+    uint8_t free_command_count;
+    uint8_t last_command;
     uint8_t count;
+    uint32_t now;  // in ticks, wraps around
+    uint32_t next_due;
 } scene_delay_t;
 
+// Each metro is due a whole period after the previous one was due, rather than
+// after its script actually ran, so lateness never accumulates as drift.
+typedef struct {
+    int16_t m;       // period in ms
+    bool act;
+    uint8_t script;  // the script to run
+    int32_t timer;   // ticks until the metro is next due
+    uint8_t load;    // how long its script last took, as a % of the period
+} scene_metro_t;
+
+// what happens to metro ticks that are missed, i.e. are still waiting to run
+// when the next tick of the same metro is due (see M.POL)
+typedef enum {
+    METRO_SKIP,      // run the first, drop the rest, and stay on time
+    METRO_CATCH_UP,  // run them all, one after another
+    METRO_THROTTLE,  // run the first, then start a new period once it's done
+    METRO_POLICY_COUNT
+} metro_policy_t;
+
 typedef struct {
-    tele_command_t commands[STACK_OP_SIZE];
+    tele_bytecode_t commands[STACK_OP_SIZE];
     uint8_t top;
 } scene_stack_op_t;
 
@@ -93,13 +168,39 @@ typedef struct {
     tele_command_t c[SCRIPT_MAX_COMMANDS];
 } scene_script_t;
 
+// a script with any lines that only call another script (e.g. SCRIPT 5)
+// replaced with the lines of that script
+typedef struct {
+    uint8_t script;
+    uint8_t line;
+} scene_script_line_t;
+
+typedef struct {
+    uint8_t l;
+    scene_script_line_t lines[SCRIPT_MAX_INLINED_COMMANDS];
+} scene_inlined_script_t;
+
 typedef struct {
     scene_variables_t variables;
+    // only the selected bank of patterns is held here, the others are kept by
+    // the target (see tele_pattern_bank_read)
     scene_pattern_t patterns[PATTERN_COUNT];
+    uint8_t pattern_bank;
+    bool pattern_bank_changed;  // since it was read, so it needs writing back
+    scene_queue_t queue;
     scene_delay_t delay;
     scene_stack_op_t stack_op;
-    int16_t tr_pulse_timer[TR_COUNT];
+    int32_t tr_pulse_timer[TR_COUNT];  // in ticks
+    uint8_t time_ticks;  // ticks towards the next ms of TIME
+    scene_metro_t metros[METRO_COUNT];
+    uint32_t metro_late;  // the most ticks any metro has run late (M.LATE)
+    uint16_t metro_missed;  // the number of ticks missed (M.OVER)
+    uint8_t metro_policy;   // a metro_policy_t
     scene_script_t scripts[SCRIPT_COUNT];
+    // compiled copies of the scripts, these are kept up to date by the script
+    // manipulation functions, and are not saved to flash
+    tele_bytecode_t bytecode[SCRIPT_COUNT][SCRIPT_MAX_COMMANDS];
+    scene_inlined_script_t inlined[SCRIPT_COUNT];
 } scene_state_t;
 
 extern void ss_init(scene_state_t *ss);
@@ -130,12 +231,56 @@ extern int16_t ss_get_pattern_val(scene_state_t *ss, size_t pattern,
                                   size_t idx);
 extern void ss_set_pattern_val(scene_state_t *ss, size_t pattern, size_t idx,
                                int16_t val);
+extern int16_t *ss_edit_pattern_vals(scene_state_t *ss, size_t pattern);
 extern scene_pattern_t *ss_patterns_ptr(scene_state_t *ss);
 extern size_t ss_patterns_size(void);
 
+// pattern banks
+extern void ss_pattern_bank_init(scene_pattern_t *patterns);
+extern uint8_t ss_get_pattern_bank(scene_state_t *ss);
+extern void ss_set_pattern_bank(scene_state_t *ss, uint8_t bank);
+extern void ss_select_pattern_bank(scene_state_t *ss, uint8_t bank);
+extern void ss_write_back_pattern_bank(scene_state_t *ss);
+
+void ss_queue_init(scene_state_t *ss);
+void ss_queue_push(scene_state_t *ss, int16_t value);
+// the value pushed age values before the newest one
+int16_t ss_queue_get(scene_state_t *ss, uint8_t age);
+void ss_queue_set_len(scene_state_t *ss, uint8_t len);
+void ss_queue_fill(scene_state_t *ss, int16_t value);
+int16_t ss_queue_avg(scene_state_t *ss);
+int16_t ss_queue_min(scene_state_t *ss);
+int16_t ss_queue_max(scene_state_t *ss);
+
+void ss_metros_init(scene_state_t *ss);
+// the period of metro i in ticks
+uint32_t ss_get_metro_period(scene_state_t *ss, size_t i);
+// start a new period of metro i from now
+void ss_reset_metro(scene_state_t *ss, size_t i);
+// the total load of the active metros, as a % of the time available
+uint8_t ss_get_metro_load(scene_state_t *ss);
+
+void ss_delays_init(scene_state_t *ss);
+// returns false (and drops the delay) if there is no room left
+bool ss_add_delay(scene_state_t *ss, uint32_t time,
+                  const tele_command_view_t *command);
+void ss_advance_delays(scene_state_t *ss, uint32_t time);
+// the time until the earliest delay is due (0 if it already is), only valid
+// if there are delays
+uint32_t ss_next_delay(scene_state_t *ss);
+// removes the earliest delay that is due, copying its command to out, returns
+// false if none are due
+bool ss_take_due_delay(scene_state_t *ss, tele_bytecode_t *out);
+
 uint8_t ss_get_script_len(scene_state_t *ss, size_t idx);
 const tele_command_t *ss_get_script_command(scene_state_t *ss,
                                             size_t script_idx, size_t c_idx);
+const tele_bytecode_t *ss_get_script_bytecode(scene_state_t *ss,
+                                              size_t script_idx, size_t c_idx);
+uint8_t ss_get_inlined_script_len(scene_state_t *ss, size_t idx);
+const tele_bytecode_t *ss_get_inlined_script_bytecode(scene_state_t *ss,
+                                                      size_t script_idx,
+                                                      size_t idx);
 void ss_overwrite_script_command(scene_state_t *ss, size_t script_idx,
                                  size_t command_idx, const tele_command_t *cmd);
 void ss_insert_script_command(scene_state_t *ss, size_t script_idx,
@@ -143,20 +288,11 @@ void ss_insert_script_command(scene_state_t *ss, size_t script_idx,
 void ss_delete_script_command(scene_state_t *ss, size_t script_idx,
                               size_t command_idx);
 
+void ss_compile_scripts(scene_state_t *ss);
+
 scene_script_t *ss_scripts_ptr(scene_state_t *ss);
 size_t ss_scripts_size(void);
 
-////////////////////////////////////////////////////////////////////////////////
-// EXEC STATE //////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-typedef struct {
-    bool if_else_condition;
-    uint8_t exec_depth;
-} exec_state_t;
-
-extern void es_init(exec_state_t *es);
-
 ////////////////////////////////////////////////////////////////////////////////
 // COMMAND STATE ///////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -173,6 +309,8 @@ extern int16_t cs_stack_size(command_state_t *cs);
 
 // by declaring the following static inline, each compilation unit (i.e. C
 // file), gets its own copy of the function
+// there are no bounds checks, validate rejects any command that would need
+// more than STACK_SIZE values and compile_command refuses to compile one
 static inline int16_t cs_pop(command_state_t *cs) {
     cs->stack.top--;
     return cs->stack.values[cs->stack.top];
@@ -184,4 +322,39 @@ static inline void cs_push(command_state_t *cs, int16_t data) {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// EXEC STATE //////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// Scripts (and the commands in them) are run by a loop over a fixed size stack
+// of frames rather than by recursion, each SCRIPT call pushes a new frame, and
+// when the called script has finished the caller resumes where it left off.
+typedef struct {
+    const tele_bytecode_t *bytecode;  // the command being run
+    int8_t script;                    // -1 if not running a script
+    uint8_t line;                     // the line of the inlined script
+    uint8_t ip;                       // the next instruction to run
+    uint8_t end;                      // stop when ip reaches end
+    bool in_post;                     // set once a MOD runs its post command
+    int16_t loop_i;                   // the post command is rerun (with I set)
+    int16_t loop_to;                  // until loop_i reaches loop_to
+    command_state_t cs;
+} exec_frame_t;
+
+typedef struct {
+    bool if_else_condition;
+    uint8_t exec_depth;
+    exec_frame_t frames[EXEC_DEPTH];
+} exec_state_t;
+
+extern void es_init(exec_state_t *es);
+// for use by MODs, run the post command once the MOD returns, either once or
+// once for each value of I from 'from' to 'to' (the MOD sets I for the first)
+extern void es_run_post_command(exec_state_t *es,
+                                const tele_command_view_t *post_command);
+extern void es_loop_post_command(exec_state_t *es,
+                                 const tele_command_view_t *post_command,
+                                 int16_t from, int16_t to);
+
+
 #endif
@@ -1,10 +1,11 @@
 #include <stdint.h>  // types
 #include <stdio.h>   // printf
 #include <string.h>
-#include <unistd.h>  // ssize_t
 
 #include "helpers.h"
+#include "ii_bus.h"
 #include "ops/op.h"
+#include "ops/patterns.h"
 #include "scanner.h"
 #include "table.h"
 #include "teletype.h"
@@ -18,9 +19,7 @@
 void clear_delays(scene_state_t *ss) {
     for (int16_t i = 0; i < TR_COUNT; i++) { ss->tr_pulse_timer[i] = 0; }
 
-    for (int16_t i = 0; i < DELAY_SIZE; i++) { ss->delay.time[i] = 0; }
-
-    ss->delay.count = 0;
+    ss_delays_init(ss);
     ss->stack_op.top = 0;
 
     tele_has_delays(false);
@@ -48,37 +47,37 @@ error_t validate(const tele_command_t *c,
     int8_t sep_count = 0;
 
     while (idx--) {  // process words right to left
-        tele_word_t word_type = c->data[idx].tag;
-        int16_t word_value = c->data[idx].value;
+        tele_word_t word_type = command_tag(c, idx);
+        int16_t word_value = command_value(c, idx);
         // A first_cmd is either at the beginning of the command or immediately
         // after the PRE_SEP or COMMAND_SEP
-        bool first_cmd = idx == 0 || c->data[idx - 1].tag == PRE_SEP ||
-                         c->data[idx - 1].tag == SUB_SEP;
+        bool first_cmd = idx == 0 || command_tag(c, idx - 1) == PRE_SEP ||
+                         command_tag(c, idx - 1) == SUB_SEP;
 
         if (word_type == NUMBER) { stack_depth++; }
         else if (word_type == OP) {
-            const tele_op_t *op = tele_ops[word_value];
+            const uint8_t flags = tele_op_flags[word_value];
 
             // if we're not a first_cmd we need to return something
-            if (!first_cmd && !op->returns) {
-                strcpy(error_msg, op->name);
+            if (!first_cmd && !(flags & OP_FLAG_RETURNS)) {
+                strcpy(error_msg, tele_ops[word_value]->name);
                 return E_NOT_LEFT;
             }
 
-            stack_depth -= op->params;
+            stack_depth -= tele_op_params[word_value];
 
             if (stack_depth < 0) {
-                strcpy(error_msg, op->name);
+                strcpy(error_msg, tele_ops[word_value]->name);
                 return E_NEED_PARAMS;
             }
 
-            stack_depth += op->returns ? 1 : 0;
+            stack_depth += flags & OP_FLAG_RETURNS ? 1 : 0;
 
             // if we are in the first_cmd position and there is a set fn
             // decrease the stack depth
             // TODO this is technically wrong. the only reason we get away with
             // it is that it's idx == 0, and the while loop is about to end.
-            if (first_cmd && op->set != NULL) stack_depth--;
+            if (first_cmd && flags & OP_FLAG_SET) stack_depth--;
         }
         else if (word_type == MOD) {
             error_t mod_error = E_OK;
@@ -105,7 +104,7 @@ error_t validate(const tele_command_t *c,
 
             if (idx == 0) return E_PLACE_PRE_SEP;
 
-            if (c->data[0].tag != MOD) return E_PLACE_PRE_SEP;
+            if (command_tag(c, 0) != MOD) return E_PLACE_PRE_SEP;
 
             if (stack_depth > 1) return E_EXTRA_PARAMS;
 
@@ -120,6 +119,10 @@ error_t validate(const tele_command_t *c,
             // reset the stack depth
             stack_depth = 0;
         }
+
+        // the stack only ever grows when a value is pushed, so checking after
+        // each word is enough to guarantee that cs_push never overruns it
+        if (stack_depth > STACK_SIZE) return E_STACK_OVERFLOW;
     }
 
     if (stack_depth > 1)
@@ -137,26 +140,19 @@ process_result_t run_script(scene_state_t *ss, size_t script_no) {
     return run_script_with_exec_state(ss, &es, script_no);
 }
 
+static process_result_t run_frames(scene_state_t *ss, exec_state_t *es,
+                                   uint8_t base_depth);
+static bool push_script_frame(scene_state_t *ss, exec_state_t *es,
+                              size_t script_no);
+
 process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
                                             size_t script_no) {
-    process_result_t result = {.has_value = false, .value = 0 };
-
-    // increase the execution depth on each call (e.g. from SCRIPT)
-    es->exec_depth++;
-    // only allow the depth to reach 8
-    // (if we want to allow this number to be any bigger we really should
-    // convert this recursive call to use some sort of trampoline!)
-    if (es->exec_depth > 8) { return result; }
-
-    for (size_t i = 0; i < ss_get_script_len(ss, script_no); i++) {
-        result =
-            process_command(ss, es, ss_get_script_command(ss, script_no, i));
+    const uint8_t base_depth = es->exec_depth;
+    if (!push_script_frame(ss, es, script_no)) {
+        process_result_t result = {.has_value = false, .value = 0 };
+        return result;
     }
-
-    // decrease the depth once the commands have been run
-    es->exec_depth--;
-
-    return result;
+    return run_frames(ss, es, base_depth);
 }
 
 process_result_t run_command(scene_state_t *ss, const tele_command_t *cmd) {
@@ -172,128 +168,409 @@ process_result_t run_command(scene_state_t *ss, const tele_command_t *cmd) {
 // run a single command inside a given exec_state
 process_result_t process_command(scene_state_t *ss, exec_state_t *es,
                                  const tele_command_t *c) {
-    command_state_t cs;
-    cs_init(&cs);  // initialise this here as well as inside the loop, in case
-                   // the command has 0 length
-
-    // 1. Do we have a PRE seperator?
-    // ------------------------------
-    // if we do then only process the PRE part, the MOD will determine if the
-    // POST should be run and take care of running it
-    ssize_t start_idx = 0;
-    ssize_t end_idx = c->separator == -1 ? c->length : c->separator;
-
-    // 2. Determine the location of all the SUB commands
-    // -------------------------------------------------
-    // an array of structs to hold the start and end of each sub command
-    struct sub_idx {
-        ssize_t start;
-        ssize_t end;
-    } subs[COMMAND_MAX_LENGTH];
-
-    ssize_t sub_len = 0;
-    ssize_t sub_start = 0;
-
-    // iterate through c->data to find all the SUB_SEPs and add to the array
-    for (ssize_t idx = start_idx; idx < end_idx; idx++) {
-        tele_word_t word_type = c->data[idx].tag;
-        if (word_type == SUB_SEP && idx > sub_start) {
-            subs[sub_len].start = sub_start;
-            subs[sub_len].end = idx - 1;
-            sub_len++;
-            sub_start = idx + 1;
-        }
-    }
+    tele_bytecode_t bytecode;
+    compile_command(c, &bytecode);
+    return process_bytecode(ss, es, &bytecode);
+}
+
+// run a single compiled command inside a given exec_state
+process_result_t process_bytecode(scene_state_t *ss, exec_state_t *es,
+                                  const tele_bytecode_t *bc) {
+    // if we have a PRE separator then only process the PRE part, the MOD will
+    // determine if the POST should be run
+    const tele_command_view_t view = {
+        .bytecode = bc,
+        .start = 0,
+        .end = bc->separator == -1 ? bc->length : bc->separator
+    };
+    return process_command_view(ss, es, &view);
+}
+
+static void start_frame_command(exec_frame_t *frame, const tele_bytecode_t *bc,
+                                uint8_t start, uint8_t end) {
+    frame->bytecode = bc;
+    frame->ip = start;
+    frame->end = end;
+    frame->in_post = false;
+    frame->loop_i = 0;
+    frame->loop_to = 0;
+    cs_init(&frame->cs);
+}
+
+static void start_frame_script_line(scene_state_t *ss, exec_frame_t *frame) {
+    // calls to other scripts may have been inlined, so we use the inlined
+    // version of the script, see ss_inline_script
+    const tele_bytecode_t *bc =
+        ss_get_inlined_script_bytecode(ss, frame->script, frame->line);
+    start_frame_command(frame, bc, 0,
+                        bc->separator == -1 ? bc->length : bc->separator);
+}
+
+// returns false if there is no room left for another frame, or the script is
+// empty, in which case there's nothing to run
+static bool push_script_frame(scene_state_t *ss, exec_state_t *es,
+                              size_t script_no) {
+    if (es->exec_depth == EXEC_DEPTH) return false;
+    if (ss_get_inlined_script_len(ss, script_no) == 0) return false;
+
+    exec_frame_t *frame = &es->frames[es->exec_depth++];
+    frame->script = script_no;
+    frame->line = 0;
+    start_frame_script_line(ss, frame);
+    return true;
+}
 
-    // the last sub command won't have been added, manually add it here
-    if (end_idx > sub_start) {
-        subs[sub_len].start = sub_start;
-        subs[sub_len].end = end_idx - 1;
-        sub_len++;
+// run part of a compiled command inside a given exec_state
+process_result_t process_command_view(scene_state_t *ss, exec_state_t *es,
+                                      const tele_command_view_t *view) {
+    const uint8_t base_depth = es->exec_depth;
+    if (es->exec_depth == EXEC_DEPTH) {
+        process_result_t result = {.has_value = false, .value = 0 };
+        return result;
     }
 
-    // 3. Loop through each sub command and execute it
-    // -----------------------------------------------
-    // iterate through sub commands from left to right
-    for (ssize_t sub_idx = 0; sub_idx < sub_len; sub_idx++) {
-        const ssize_t sub_start = subs[sub_idx].start;
-        const ssize_t sub_end = subs[sub_idx].end;
-
-        // initialise the command state for each sub, otherwise a value left on
-        // the stack for the previous sub, can cause the set fn to trigger when
-        // it shouldn't
-        cs_init(&cs);
-
-        // as we are using a stack based language, we must process commands from
-        // right to left
-        for (ssize_t idx = sub_end; idx >= sub_start; idx--) {
-            const tele_word_t word_type = c->data[idx].tag;
-            const int16_t word_value = c->data[idx].value;
-
-            if (word_type == NUMBER) { cs_push(&cs, word_value); }
-            else if (word_type == OP) {
-                const tele_op_t *op = tele_ops[word_value];
-
-                // if we're in the first command position, and there is a set fn
-                // pointer and we have enough params, then run set, else run get
-                if (idx == sub_start && op->set != NULL &&
-                    cs_stack_size(&cs) >= op->params + 1)
-                    op->set(op->data, ss, es, &cs);
-                else
-                    op->get(op->data, ss, es, &cs);
+    exec_frame_t *frame = &es->frames[es->exec_depth++];
+    frame->script = -1;
+    start_frame_command(frame, view->bytecode, view->start, view->end);
+    return run_frames(ss, es, base_depth);
+}
+
+// The executor can be built in one of 2 ways, either as a switch statement
+// inside a loop, or if TELE_THREADED_DISPATCH is defined, using GCC's computed
+// goto extension to jump directly from one instruction handler to the next.
+// Both share the same handlers via the INSTR and NEXT_INSTR macros.
+#ifdef TELE_THREADED_DISPATCH
+#define INSTR(tag) instr_##tag:
+#define NEXT_INSTR()                      \
+    do {                                  \
+        if (ip == end) goto instr_done;   \
+        instr = ip++;                     \
+        goto *instr_handlers[instr->tag]; \
+    } while (0)
+#else
+#define INSTR(tag) case tag:
+#define NEXT_INSTR() break
+#endif
+
+// run the instructions of a frame up to its end, returns false if it was
+// interrupted by a call to SCRIPT, the frame can be resumed once the new frame
+// has finished
+static bool run_frame_instructions(scene_state_t *ss, exec_state_t *es,
+                                   exec_frame_t *frame) {
+    command_state_t *cs = &frame->cs;
+    const tele_bytecode_t *bc = frame->bytecode;
+    const tele_instr_t *ip = &bc->data[frame->ip];
+    const tele_instr_t *end = &bc->data[frame->end];
+    const tele_instr_t *instr;
+    int16_t a, b;
+
+    // sub commands have already been reversed by the compiler, so we can run
+    // straight through from left to right
+#ifdef TELE_THREADED_DISPATCH
+    static const void *const instr_handlers[I__LENGTH] = {
+        [I_NUMBER] = &&instr_I_NUMBER, [I_GET] = &&instr_I_GET,
+        [I_SET] = &&instr_I_SET,       [I_MOD] = &&instr_I_MOD,
+        [I_SUB_SEP] = &&instr_I_SUB_SEP,
+        [I_PEEK] = &&instr_I_PEEK,     [I_POKE] = &&instr_I_POKE,
+        [I_ADD] = &&instr_I_ADD,       [I_SUB] = &&instr_I_SUB,
+        [I_EQ] = &&instr_I_EQ,         [I_NE] = &&instr_I_NE,
+        [I_LT] = &&instr_I_LT,         [I_GT] = &&instr_I_GT,
+        [I_SCRIPT] = &&instr_I_SCRIPT,
+        [I_PATTERN_LOOP] = &&instr_I_PATTERN_LOOP,
+        [I_ADD_TO_VAR] = &&instr_I_ADD_TO_VAR,
+        [I_NUMBER_GET] = &&instr_I_NUMBER_GET,
+        [I_NUMBER_SET] = &&instr_I_NUMBER_SET,
+        [I_NUMBER_POKE] = &&instr_I_NUMBER_POKE
+    };
+
+    NEXT_INSTR();
+    {
+#else
+    while (ip != end) {
+        instr = ip++;
+        switch (instr->tag) {
+#endif
+        INSTR(I_NUMBER) {
+            cs_push(cs, instr->value);
+            NEXT_INSTR();
+        }
+        INSTR(I_GET) {
+            const tele_op_t *op = tele_ops[instr->value];
+            op->get(op->data, ss, es, cs);
+            NEXT_INSTR();
+        }
+        INSTR(I_SET) {
+            const tele_op_t *op = tele_ops[instr->value];
+            op->set(op->data, ss, es, cs);
+            NEXT_INSTR();
+        }
+        INSTR(I_MOD) {
+            // the post command is run in place, a MOD can only appear in the
+            // PRE part so the view never contains another MOD
+            const tele_command_view_t post_command = {
+                .bytecode = bc, .start = bc->separator, .end = bc->length
+            };
+            frame->ip = ip - bc->data;
+            tele_mods[instr->value]->func(ss, es, cs, &post_command);
+
+            // the MOD may have moved the frame on to the post command
+            ip = &bc->data[frame->ip];
+            end = &bc->data[frame->end];
+            NEXT_INSTR();
+        }
+        INSTR(I_SUB_SEP) {
+            // initialise the command state for each sub, otherwise a value
+            // left on the stack for the previous sub, can cause the set fn to
+            // trigger when it shouldn't
+            cs_init(cs);
+            NEXT_INSTR();
+        }
+        INSTR(I_PEEK) {
+            cs_push(cs, *(int16_t *)((char *)ss + instr->value));
+            NEXT_INSTR();
+        }
+        INSTR(I_POKE) {
+            *(int16_t *)((char *)ss + instr->value) = cs_pop(cs);
+            NEXT_INSTR();
+        }
+        // the following must match their counterparts in ops/maths.c
+        INSTR(I_ADD) {
+            a = cs_pop(cs);
+            b = cs_pop(cs);
+            cs_push(cs, a + b);
+            NEXT_INSTR();
+        }
+        INSTR(I_SUB) {
+            a = cs_pop(cs);
+            b = cs_pop(cs);
+            cs_push(cs, a - b);
+            NEXT_INSTR();
+        }
+        INSTR(I_EQ) {
+            a = cs_pop(cs);
+            b = cs_pop(cs);
+            cs_push(cs, a == b);
+            NEXT_INSTR();
+        }
+        INSTR(I_NE) {
+            a = cs_pop(cs);
+            b = cs_pop(cs);
+            cs_push(cs, a != b);
+            NEXT_INSTR();
+        }
+        INSTR(I_LT) {
+            a = cs_pop(cs);
+            b = cs_pop(cs);
+            cs_push(cs, a < b);
+            NEXT_INSTR();
+        }
+        INSTR(I_GT) {
+            a = cs_pop(cs);
+            b = cs_pop(cs);
+            cs_push(cs, a > b);
+            NEXT_INSTR();
+        }
+        INSTR(I_SCRIPT) {
+            // must match op_SCRIPT_get in ops/controlflow.c
+            uint16_t script_no = cs_pop(cs) - 1;
+            if (script_no < SCRIPT_COUNT && script_no != INIT_SCRIPT &&
+                script_no != METRO_SCRIPT &&
+                push_script_frame(ss, es, script_no)) {
+                frame->ip = ip - bc->data;
+                return false;
             }
-            else if (word_type == MOD) {
-                tele_command_t post_command;
-                copy_post_command(&post_command, c);
-                tele_mods[word_value]->func(ss, es, &cs, &post_command);
+            NEXT_INSTR();
+        }
+        INSTR(I_PATTERN_LOOP) {
+            // in place of I_MOD for L, the post command is never run
+            const tele_command_view_t post_command = {
+                .bytecode = bc, .start = bc->separator, .end = bc->length
+            };
+            pattern_loop_t loop;
+            if (match_pattern_loop(&post_command, &loop)) {
+                a = cs_pop(cs);
+                b = cs_pop(cs);
+                p_loop(ss, es, &loop, a, b);
+                NEXT_INSTR();
             }
+
+            // lower_loop_idioms only emits I_PATTERN_LOOP for post commands
+            // that match, but if one ever doesn't run it as an ordinary L
+            // (value is still the index of the MOD), as for I_MOD
+            frame->ip = ip - bc->data;
+            tele_mods[instr->value]->func(ss, es, cs, &post_command);
+            ip = &bc->data[frame->ip];
+            end = &bc->data[frame->end];
+            NEXT_INSTR();
+        }
+        // superinstructions, each is followed by an I_OPERAND which holds
+        // their 2nd value
+        INSTR(I_ADD_TO_VAR) {
+            int16_t *v = (int16_t *)((char *)ss + instr->value);
+            *v = *v + (ip++)->value;
+            NEXT_INSTR();
+        }
+        INSTR(I_NUMBER_GET) {
+            const tele_op_t *op = tele_ops[instr->value];
+            cs_push(cs, (ip++)->value);
+            op->get(op->data, ss, es, cs);
+            NEXT_INSTR();
+        }
+        INSTR(I_NUMBER_SET) {
+            const tele_op_t *op = tele_ops[instr->value];
+            cs_push(cs, (ip++)->value);
+            op->set(op->data, ss, es, cs);
+            NEXT_INSTR();
         }
+        INSTR(I_NUMBER_POKE) {
+            *(int16_t *)((char *)ss + instr->value) = (ip++)->value;
+            NEXT_INSTR();
+        }
+#ifndef TELE_THREADED_DISPATCH
+        }
+#endif
     }
 
-    // 4. Return
-    // ---------
-    // sometimes we have single value left of the stack, if so return it
-    if (cs_stack_size(&cs)) {
-        process_result_t o = {.has_value = true, .value = cs_pop(&cs) };
-        return o;
-    }
-    else {
-        process_result_t o = {.has_value = false, .value = 0 };
-        return o;
+#ifdef TELE_THREADED_DISPATCH
+instr_done:
+#endif
+    frame->ip = frame->end;
+    return true;
+}
+
+#undef INSTR
+#undef NEXT_INSTR
+
+// run frames until the stack is back down to base_depth, returns the result
+// of the last command run by the frame at base_depth, the ii writes made are
+// sent once the outermost call has finished (see ii_tx_begin)
+static process_result_t run_frames(scene_state_t *ss, exec_state_t *es,
+                                   uint8_t base_depth) {
+    process_result_t result = {.has_value = false, .value = 0 };
+    ii_tx_begin(es->exec_depth > base_depth ? es->frames[base_depth].script
+                                            : -1);
+
+    while (es->exec_depth > base_depth) {
+        exec_frame_t *frame = &es->frames[es->exec_depth - 1];
+
+        // if a script was called, run that first, we'll be back here again
+        // when it's finished
+        if (!run_frame_instructions(ss, es, frame)) continue;
+
+        // loop the post command (for L) until we reach the end value
+        if (frame->loop_i != frame->loop_to) {
+            frame->loop_i += frame->loop_i < frame->loop_to ? 1 : -1;
+            ss->variables.i = frame->loop_i;
+            frame->ip = frame->bytecode->separator;
+            cs_init(&frame->cs);
+            continue;
+        }
+
+        // sometimes we have single value left of the stack, if so return it
+        // (commands with a MOD never return a value)
+        if (es->exec_depth == base_depth + 1) {
+            result.has_value = !frame->in_post && cs_stack_size(&frame->cs);
+            result.value = result.has_value ? cs_pop(&frame->cs) : 0;
+        }
+
+        // move on to the next line of the script, or finish with the frame
+        if (frame->script != -1 &&
+            ++frame->line < ss_get_inlined_script_len(ss, frame->script)) {
+            start_frame_script_line(ss, frame);
+        }
+        else {
+            es->exec_depth--;
+        }
     }
+
+    ii_tx_end();
+    return result;
 }
 
 
 /////////////////////////////////////////////////////////////////
 // TICK /////////////////////////////////////////////////////////
 
-void tele_tick(scene_state_t *ss, uint8_t time) {
-    // inc time
-    if (ss->variables.time_act) ss->variables.time += time;
-
-    // process delays
-    for (int16_t i = 0; i < DELAY_SIZE; i++) {
-        if (ss->delay.time[i]) {
-            ss->delay.time[i] -= time;
-            if (ss->delay.time[i] <= 0) {
-                run_command(ss, &ss->delay.commands[i]);
-                ss->delay.time[i] = 0;
-                ss->delay.count--;
-                if (ss->delay.count == 0) tele_has_delays(false);
-            }
+// the time until the TR pulse on output i ends, tick clamps the pulse to
+// TR.TIME in case it has been shortened since the pulse started
+static uint32_t tr_pulse_remaining(scene_state_t *ss, uint8_t i) {
+    int32_t remaining = ss->tr_pulse_timer[i];
+    int32_t tr_time = (int32_t)ss->variables.tr_time[i] * TICKS_PER_MS;
+    if (tr_time < 0) tr_time = 0;
+    if (remaining > tr_time) remaining = tr_time;
+    return remaining > 0 ? remaining : 0;
+}
+
+uint32_t tele_next_deadline(scene_state_t *ss) {
+    uint32_t deadline = TELE_NO_DEADLINE;
+
+    if (ss->delay.count) deadline = ss_next_delay(ss);
+
+    for (uint8_t i = 0; i < METRO_COUNT; i++) {
+        const scene_metro_t *metro = &ss->metros[i];
+        if (metro->act) {
+            const uint32_t remaining = metro->timer > 0 ? metro->timer : 0;
+            if (remaining < deadline) deadline = remaining;
         }
     }
 
-    // process tr pulses
-    for (int16_t i = 0; i < TR_COUNT; i++) {
+    for (uint8_t i = 0; i < TR_COUNT; i++) {
         if (ss->tr_pulse_timer[i]) {
-            // prevent tr_pulse_timer from being greater than tr_time
-            int16_t tr_time = ss->variables.tr_time[i];
-            if (tr_time < 0) tr_time = 0;
-            if (ss->tr_pulse_timer[i] > tr_time)
-                ss->tr_pulse_timer[i] = tr_time;
+            const uint32_t remaining = tr_pulse_remaining(ss, i);
+            if (remaining < deadline) deadline = remaining;
+        }
+    }
+
+    return deadline;
+}
+
+// run metro i, which was due late ticks ago, the next tick is due a period
+// after this one was (so a change to M takes effect from the next period, and
+// lateness doesn't accumulate as drift) unless the policy says otherwise
+static void run_metro(scene_state_t *ss, uint8_t i, uint32_t late) {
+    scene_metro_t *metro = &ss->metros[i];
+    const uint32_t period = ss_get_metro_period(ss, i);
+    if (late > ss->metro_late) ss->metro_late = late;
+
+    // the ticks after this one that are already due have been missed, when
+    // catching up each of them is counted when it runs
+    const uint32_t missed = late / period;
+    if (missed) {
+        const bool catch_up = ss->metro_policy == METRO_CATCH_UP;
+        const uint32_t total = ss->metro_missed + (catch_up ? 1 : missed);
+        ss->metro_missed = total > UINT16_MAX ? UINT16_MAX : total;
+    }
 
-            ss->tr_pulse_timer[i] -= time;
+    const uint32_t start = tele_get_ticks();
+    run_script(ss, metro->script);
+    const uint32_t run_time = tele_get_ticks() - start;
+    const uint32_t load = run_time * 100 / period;
+    metro->load = load > UINT8_MAX ? UINT8_MAX : load;
+
+    if (ss->metro_policy == METRO_CATCH_UP)
+        metro->timer += period;
+    else if (ss->metro_policy == METRO_THROTTLE &&
+             (missed || run_time >= period))
+        metro->timer = late + run_time + period;
+    else
+        metro->timer += (missed + 1) * period;
+}
+
+// advance by time, where nothing is due any sooner than time, late is how
+// much more time had passed when tele_tick was called
+static void tick(scene_state_t *ss, uint32_t time, uint32_t late) {
+    // inc time, which is in ms
+    if (ss->variables.time_act) {
+        const uint32_t ticks = ss->time_ticks + time;
+        ss->variables.time += ticks / TICKS_PER_MS;
+        ss->time_ticks = ticks % TICKS_PER_MS;
+    }
+
+    // process tr pulses first, so that a pulse started by a delay isn't
+    // shortened
+    for (uint8_t i = 0; i < TR_COUNT; i++) {
+        if (ss->tr_pulse_timer[i]) {
+            ss->tr_pulse_timer[i] = tr_pulse_remaining(ss, i) - time;
 
             if (ss->tr_pulse_timer[i] <= 0) {
                 ss->tr_pulse_timer[i] = 0;
@@ -302,6 +579,37 @@ void tele_tick(scene_state_t *ss, uint8_t time) {
             }
         }
     }
+
+    // process delays, any added while doing so are due in a later tick
+    ss_advance_delays(ss, time);
+    tele_bytecode_t delayed;
+    bool ran_delays = false;
+    while (ss_take_due_delay(ss, &delayed)) {
+        exec_state_t es;
+        es_init(&es);
+        process_bytecode(ss, &es, &delayed);
+        ran_delays = true;
+    }
+    if (ran_delays && ss->delay.count == 0) tele_has_delays(false);
+
+    for (uint8_t i = 0; i < METRO_COUNT; i++) {
+        scene_metro_t *metro = &ss->metros[i];
+        if (!metro->act) continue;
+
+        metro->timer -= time;
+        if (metro->timer <= 0) run_metro(ss, i, late);
+    }
+}
+
+void tele_tick(scene_state_t *ss, uint32_t time) {
+    // step from one deadline to the next, so that everything runs in the order
+    // it's due however long time is
+    do {
+        uint32_t step = tele_next_deadline(ss);
+        if (step > time) step = time;
+        time -= step;
+        tick(ss, step, time);
+    } while (time);
 }
 
 /////////////////////////////////////////////////////////////////
@@ -320,7 +628,8 @@ const char *tele_error(error_t e) {
                                    "NO SUB SEP IN PRE",
                                    "MOVE LEFT",
                                    "NEED SPACE AFTER :",
-                                   "NEED SPACE AFTER ;" };
+                                   "NEED SPACE AFTER ;",
+                                   "STACK OVERFLOW" };
 
     return error_string[e];
 }
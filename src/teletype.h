@@ -5,6 +5,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "bytecode.h"
 #include "command.h"
 #include "state.h"
 
@@ -24,7 +25,8 @@ typedef enum {
     E_NO_SUB_SEP_IN_PRE,
     E_NOT_LEFT,
     E_NEED_SPACE_PRE_SEP,
-    E_NEED_SPACE_SUB_SEP
+    E_NEED_SPACE_SUB_SEP,
+    E_STACK_OVERFLOW
 } error_t;
 
 typedef struct {
@@ -43,8 +45,21 @@ process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
 process_result_t run_command(scene_state_t *ss, const tele_command_t *cmd);
 process_result_t process_command(scene_state_t *ss, exec_state_t *es,
                                  const tele_command_t *c);
+process_result_t process_bytecode(scene_state_t *ss, exec_state_t *es,
+                                  const tele_bytecode_t *bc);
+process_result_t process_command_view(scene_state_t *ss, exec_state_t *es,
+                                      const tele_command_view_t *view);
 
-void tele_tick(scene_state_t *ss, uint8_t);
+#define TELE_NO_DEADLINE UINT32_MAX
+
+// advance time by any number of ticks (see TICKS_PER_MS), running everything
+// that becomes due in that time (delays, the end of TR pulses and the metro) in
+// the order it is due
+void tele_tick(scene_state_t *ss, uint32_t time);
+// the number of ticks until something will be due (0 if it already is), or
+// TELE_NO_DEADLINE if nothing is pending, a host can sleep until then rather
+// than calling tele_tick at a fixed rate
+uint32_t tele_next_deadline(scene_state_t *ss);
 
 void clear_delays(scene_state_t *ss);
 
@@ -4,14 +4,18 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "ii_bus.h"
+#include "state.h"
+
 // These functions are for interacting with the teletype hardware, each target
 // must provide it's own implementation
 
-// called when M or M.ACT are updated
+// called when M or M.ACT are updated (the metro itself is run by tele_tick)
 extern void tele_metro_updated(void);
 
-// called by M.RESET
-extern void tele_metro_reset(void);
+// a free running clock in ticks (see TICKS_PER_MS), used to measure how long
+// the metro scripts take to run
+extern uint32_t tele_get_ticks(void);
 
 extern void tele_tr(uint8_t i, int16_t v);
 extern void tele_cv(uint8_t i, int16_t v, uint8_t s);
@@ -24,13 +28,25 @@ extern void tele_has_delays(bool has_delays);
 extern void tele_has_stack(bool has_stack);
 
 extern void tele_cv_off(uint8_t i, int16_t v);
-extern void tele_ii_tx(uint8_t addr, uint8_t *data, uint8_t l);
-extern void tele_ii_rx(uint8_t addr, uint8_t *data, uint8_t l);
+
+// start an ii transfer (reading into t->data if t->read) and return without
+// waiting for it, the target calls ii_transfer_done when it has finished (see
+// ii_poll)
+extern void tele_ii_start(ii_transfer_t *t);
+
 extern void tele_scene(uint8_t i);
 
 // called when a pattern is updated
 extern void tele_pattern_updated(void);
 
+// the target keeps the pattern banks of the current scene, PATTERN_COUNT
+// patterns each, the selected bank is only written back when another bank is
+// selected, and only if it has changed (see ss_select_pattern_bank), as P.BANK
+// can be run from a metro script these shouldn't write to flash
+extern void tele_pattern_bank_read(uint8_t bank, scene_pattern_t *patterns);
+extern void tele_pattern_bank_write(uint8_t bank,
+                                    const scene_pattern_t *patterns);
+
 extern void tele_kill(void);
 extern void tele_mute(void);
 extern bool tele_get_input_state(uint8_t);
@@ -0,0 +1,134 @@
+// needed for clock_gettime with -std=c99
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "bytecode.h"
+#include "corpus.h"
+#include "teletype.h"
+
+// Times the executor over a set of typical script lines, then validate and the
+// executor over every line of the scenes given on the command line. Build it
+// twice, with and without TELE_THREADED_DISPATCH, to compare the 2 dispatch
+// methods (see the bench target in the Makefile).
+//
+// usage: benchmark corpus/*.txt
+
+#define ITERATIONS 1000000
+#define CORPUS_ITERATIONS 10000
+#define CORPUS_MAX_LINES 1024
+
+static const char *corpus[] = { "X 1",
+                                "X ADD X 1",
+                                "A + A 1; B - B 1",
+                                "IF EQ X 0: TR.PULSE 1",
+                                "IF GT A B: X 2; Y 3",
+                                "Y SUB Y X",
+                                "CV 1 N P.NEXT",
+                                "X WRAP ADD X 1 0 7",
+                                "L 1 4: CV I N I",
+                                "PROB 50: TR.TOG 2",
+                                "P.N 1; P.NEXT",
+                                "Z RAND 10",
+                                "L 0 15: PN 1 I RAND 7",
+                                "IF NE LT X 4 0: Z 1" };
+
+static tele_command_t corpus_commands[CORPUS_MAX_LINES];
+static tele_bytecode_t corpus_bytecode[CORPUS_MAX_LINES];
+static uint16_t corpus_lines = 0;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void add_corpus_line(const char *line, const char *filename) {
+    if (corpus_lines == CORPUS_MAX_LINES) return;
+
+    tele_command_t *cmd = &corpus_commands[corpus_lines];
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    if (parse(line, cmd, error_msg) != E_OK ||
+        validate(cmd, error_msg) != E_OK) {
+        fprintf(stderr, "%s: invalid command: %s\n", filename, line);
+        return;
+    }
+    compile_command(cmd, &corpus_bytecode[corpus_lines]);
+    corpus_lines++;
+}
+
+static void bench_corpus(scene_state_t *ss) {
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    uint64_t start = now_ns();
+    for (uint32_t n = 0; n < CORPUS_ITERATIONS; n++) {
+        for (uint16_t i = 0; i < corpus_lines; i++)
+            validate(&corpus_commands[i], error_msg);
+    }
+    const uint64_t validate_ns = now_ns() - start;
+
+    ss_variables_init(ss);
+    start = now_ns();
+    for (uint32_t n = 0; n < CORPUS_ITERATIONS; n++) {
+        for (uint16_t i = 0; i < corpus_lines; i++) {
+            exec_state_t es;
+            es_init(&es);
+            process_bytecode(ss, &es, &corpus_bytecode[i]);
+        }
+    }
+    const uint64_t process_ns = now_ns() - start;
+
+    const double runs = (double)CORPUS_ITERATIONS * corpus_lines;
+    printf("\ncorpus: %u lines\n", corpus_lines);
+    printf("%-28s %8.1f ns\n", "validate", validate_ns / runs);
+    printf("%-28s %8.1f ns\n", "process", process_ns / runs);
+}
+
+int main(int argc, char **argv) {
+    scene_state_t ss;
+    ss_init(&ss);
+
+#ifdef TELE_THREADED_DISPATCH
+    printf("dispatch: threaded\n");
+#else
+    printf("dispatch: switch\n");
+#endif
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+        tele_command_t cmd;
+        tele_bytecode_t bc;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        if (parse(corpus[i], &cmd, error_msg) != E_OK ||
+            validate(&cmd, error_msg) != E_OK) {
+            printf("invalid command: %s\n", corpus[i]);
+            return 1;
+        }
+        compile_command(&cmd, &bc);
+
+        // reset the variables each time, so that no line depends on another
+        ss_variables_init(&ss);
+        uint64_t start = now_ns();
+        for (uint32_t n = 0; n < ITERATIONS; n++) {
+            exec_state_t es;
+            es_init(&es);
+            process_bytecode(&ss, &es, &bc);
+        }
+        uint64_t elapsed = now_ns() - start;
+        total += elapsed;
+
+        printf("%-28s %8.1f ns\n", corpus[i], (double)elapsed / ITERATIONS);
+    }
+
+    printf("%-28s %8.1f ns\n", "total", (double)total / ITERATIONS);
+
+    for (int i = 1; i < argc; i++) {
+        if (!corpus_read(argv[i], add_corpus_line))
+            fprintf(stderr, "can't open %s\n", argv[i]);
+    }
+    if (corpus_lines) bench_corpus(&ss);
+
+    return 0;
+}
@@ -0,0 +1,443 @@
+#include "bytecode_tests.h"
+
+#include "greatest/greatest.h"
+
+#include "bytecode.h"
+#include "ops/op.h"
+#include "ops/op_enum.h"
+#include "teletype.h"
+
+// parses, validates and compiles text (without fusing instructions), asserting
+// that each step succeeds
+TEST compile_helper(const char* text, tele_bytecode_t* bc) {
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    ASSERT_EQm(text, parse(text, &cmd, error_msg), E_OK);
+    ASSERT_EQm(text, validate(&cmd, error_msg), E_OK);
+    compile_command_unfused(&cmd, bc);
+    PASS();
+}
+
+TEST fuse_helper(const char* text, tele_bytecode_t* bc) {
+    CHECK_CALL(compile_helper(text, bc));
+    fuse_bytecode(bc, NULL);
+    PASS();
+}
+
+TEST should_reverse_sub_commands() {
+    tele_bytecode_t bc;
+    CHECK_CALL(compile_helper("RRAND 1 2", &bc));
+
+    ASSERT_EQ(bc.length, 3);
+    ASSERT_EQ(bc.separator, -1);
+    ASSERT_EQ(bc.data[0].tag, I_NUMBER);
+    ASSERT_EQ(bc.data[0].value, 2);
+    ASSERT_EQ(bc.data[1].tag, I_NUMBER);
+    ASSERT_EQ(bc.data[1].value, 1);
+    ASSERT_EQ(bc.data[2].tag, I_GET);
+    ASSERT_EQ(bc.data[2].value, E_OP_RRAND);
+
+    PASS();
+}
+
+TEST should_resolve_get_and_set() {
+    tele_bytecode_t bc;
+
+    CHECK_CALL(compile_helper("TR.TIME 1", &bc));
+    ASSERT_EQ(bc.length, 2);
+    ASSERT_EQ(bc.data[1].tag, I_GET);
+    ASSERT_EQ(bc.data[1].value, E_OP_TR_TIME);
+
+    CHECK_CALL(compile_helper("TR.TIME 1 2", &bc));
+    ASSERT_EQ(bc.length, 3);
+    ASSERT_EQ(bc.data[2].tag, I_SET);
+    ASSERT_EQ(bc.data[2].value, E_OP_TR_TIME);
+
+    // P has 1 param, so only the 2 param version is a set
+    CHECK_CALL(compile_helper("P 1", &bc));
+    ASSERT_EQ(bc.data[1].tag, I_GET);
+    CHECK_CALL(compile_helper("P 1 2", &bc));
+    ASSERT_EQ(bc.data[2].tag, I_SET);
+
+    // ops not in the first position are always a get
+    CHECK_CALL(compile_helper("P.N P.L", &bc));
+    ASSERT_EQ(bc.data[0].tag, I_GET);
+    ASSERT_EQ(bc.data[0].value, E_OP_P_L);
+    ASSERT_EQ(bc.data[1].tag, I_SET);
+    ASSERT_EQ(bc.data[1].value, E_OP_P_N);
+
+    PASS();
+}
+
+TEST should_specialise_common_ops() {
+    tele_bytecode_t bc;
+
+    CHECK_CALL(compile_helper("X", &bc));
+    ASSERT_EQ(bc.length, 1);
+    ASSERT_EQ(bc.data[0].tag, I_PEEK);
+
+    CHECK_CALL(compile_helper("X Y", &bc));
+    ASSERT_EQ(bc.length, 2);
+    ASSERT_EQ(bc.data[0].tag, I_PEEK);
+    ASSERT_EQ(bc.data[1].tag, I_POKE);
+    ASSERT(bc.data[0].value != bc.data[1].value);
+
+    // aliases are specialised too
+    CHECK_CALL(compile_helper("+ X 2", &bc));
+    ASSERT_EQ(bc.data[2].tag, I_ADD);
+    CHECK_CALL(compile_helper("< X 2", &bc));
+    ASSERT_EQ(bc.data[2].tag, I_LT);
+
+    // and must give the same results as the ops they replace
+    scene_state_t ss;
+    ss_init(&ss);
+    exec_state_t es;
+    es_init(&es);
+    ss.variables.x = 5;
+    CHECK_CALL(compile_helper("SUB X 3", &bc));
+    ASSERT_EQ(process_bytecode(&ss, &es, &bc).value, 2);
+    CHECK_CALL(compile_helper("GT X 3", &bc));
+    ASSERT_EQ(process_bytecode(&ss, &es, &bc).value, 1);
+    CHECK_CALL(compile_helper("X 7", &bc));
+    process_bytecode(&ss, &es, &bc);
+    ASSERT_EQ(ss.variables.x, 7);
+
+    PASS();
+}
+
+TEST should_fold_pure_ops() {
+    tele_bytecode_t bc;
+
+    CHECK_CALL(compile_helper("X ADD 4 8", &bc));
+    ASSERT_EQ(bc.length, 2);
+    ASSERT_EQ(bc.data[0].tag, I_NUMBER);
+    ASSERT_EQ(bc.data[0].value, 12);
+
+    // nested ops fold all the way up, SUB 10 1 must not be reordered
+    CHECK_CALL(compile_helper("MUL 2 SUB 10 1", &bc));
+    ASSERT_EQ(bc.length, 1);
+    ASSERT_EQ(bc.data[0].value, 18);
+
+    // including table lookups
+    CHECK_CALL(compile_helper("N 12", &bc));
+    ASSERT_EQ(bc.length, 1);
+    ASSERT_EQ(bc.data[0].value, 1638);
+
+    // but not if a param isn't a literal, or the op isn't pure
+    CHECK_CALL(compile_helper("ADD X 1", &bc));
+    ASSERT_EQ(bc.length, 3);
+    CHECK_CALL(compile_helper("RAND 4", &bc));
+    ASSERT_EQ(bc.length, 2);
+
+    // ops that divide by a param give 0 for 0, so they fold too
+    CHECK_CALL(compile_helper("JI 1 0", &bc));
+    ASSERT_EQ(bc.length, 1);
+    ASSERT_EQ(bc.data[0].tag, I_NUMBER);
+    ASSERT_EQ(bc.data[0].value, 0);
+    CHECK_CALL(compile_helper("SCALE 0 0 0 10 5", &bc));
+    ASSERT_EQ(bc.length, 1);
+    ASSERT_EQ(bc.data[0].value, 0);
+    CHECK_CALL(compile_helper("/ 7 2", &bc));
+    ASSERT_EQ(bc.length, 1);
+    ASSERT_EQ(bc.data[0].value, 3);
+
+    // or across sub commands
+    CHECK_CALL(compile_helper("1; ADD 2 3", &bc));
+    ASSERT_EQ(bc.length, 3);
+    ASSERT_EQ(bc.data[2].value, 5);
+
+    // the command itself is left untouched for display
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    char print[32];
+    parse("CV 1 N 12", &cmd, error_msg);
+    validate(&cmd, error_msg);
+    compile_command(&cmd, &bc);
+    print_command(&cmd, print);
+    ASSERT_STR_EQ(print, "CV 1 N 12");
+
+    PASS();
+}
+
+TEST should_fuse_instructions() {
+    tele_bytecode_t bc;
+
+    CHECK_CALL(fuse_helper("X ADD X 2", &bc));
+    ASSERT_EQ(bc.length, 2);
+    ASSERT_EQ(bc.data[0].tag, I_ADD_TO_VAR);
+    ASSERT_EQ(bc.data[1].tag, I_OPERAND);
+    ASSERT_EQ(bc.data[1].value, 2);
+
+    CHECK_CALL(fuse_helper("X SUB X 2", &bc));
+    ASSERT_EQ(bc.data[0].tag, I_ADD_TO_VAR);
+    ASSERT_EQ(bc.data[1].value, -2);
+
+    CHECK_CALL(fuse_helper("X 2", &bc));
+    ASSERT_EQ(bc.length, 2);
+    ASSERT_EQ(bc.data[0].tag, I_NUMBER_POKE);
+
+    // the variables must match
+    CHECK_CALL(fuse_helper("X ADD Y 2", &bc));
+    ASSERT_EQ(bc.data[0].tag, I_NUMBER);
+
+    // SUB isn't commutative
+    CHECK_CALL(fuse_helper("X SUB 2 X", &bc));
+    ASSERT_EQ(bc.data[0].tag, I_PEEK);
+
+    // the separator is moved along with the instructions
+    CHECK_CALL(fuse_helper("IF TR.TIME 1: TR.PULSE 2", &bc));
+    ASSERT_EQ(bc.separator, 3);
+    ASSERT_EQ(bc.data[0].tag, I_NUMBER_GET);
+    ASSERT_EQ(bc.data[0].value, E_OP_TR_TIME);
+    ASSERT_EQ(bc.data[2].tag, I_MOD);
+    ASSERT_EQ(bc.data[3].tag, I_NUMBER_GET);
+    ASSERT_EQ(bc.data[3].value, E_OP_TR_PULSE);
+    ASSERT_EQ(bc.length, 5);
+
+    // and must give the same results
+    scene_state_t ss;
+    ss_init(&ss);
+    exec_state_t es;
+    es_init(&es);
+    ss.variables.x = 5;
+    CHECK_CALL(fuse_helper("X ADD 3 X", &bc));
+    process_bytecode(&ss, &es, &bc);
+    ASSERT_EQ(ss.variables.x, 8);
+    CHECK_CALL(fuse_helper("TR.TIME 1 20", &bc));
+    ASSERT_EQ(bc.data[1].tag, I_NUMBER_SET);
+    process_bytecode(&ss, &es, &bc);
+    ASSERT_EQ(ss.variables.tr_time[0], 20);
+
+    PASS();
+}
+
+TEST should_separate_sub_commands() {
+    tele_bytecode_t bc;
+
+    CHECK_CALL(compile_helper("X 1; TR.TIME 1 2", &bc));
+    ASSERT_EQ(bc.length, 6);
+    ASSERT_EQ(bc.data[2].tag, I_SUB_SEP);
+    ASSERT_EQ(bc.data[5].tag, I_SET);
+    ASSERT_EQ(bc.data[5].value, E_OP_TR_TIME);
+
+    // empty sub commands are dropped
+    CHECK_CALL(compile_helper("X 1; ; Y 2 ; ", &bc));
+    ASSERT_EQ(bc.length, 5);
+
+    PASS();
+}
+
+TEST should_place_post_command_after_mod() {
+    tele_bytecode_t bc;
+    CHECK_CALL(compile_helper("IF TR.TIME 1: P.N 1; Z 2", &bc));
+
+    ASSERT_EQ(bc.separator, 3);
+    ASSERT_EQ(bc.data[1].tag, I_GET);
+    ASSERT_EQ(bc.data[1].value, E_OP_TR_TIME);
+    ASSERT_EQ(bc.data[2].tag, I_MOD);
+    ASSERT_EQ(bc.data[2].value, E_MOD_IF);
+    ASSERT_EQ(bc.length, 8);
+
+    tele_bytecode_t post;
+    const tele_command_view_t view = {
+        .bytecode = &bc, .start = bc.separator, .end = bc.length
+    };
+    copy_command_view(&post, &view);
+    ASSERT_EQ(post.separator, -1);
+    ASSERT_EQ(post.length, 5);
+    ASSERT_EQ(post.data[1].tag, I_SET);
+    ASSERT_EQ(post.data[1].value, E_OP_P_N);
+
+    PASS();
+}
+
+// compiles text and returns whether it was lowered to a pattern loop
+TEST lower_helper(const char* text, tele_bytecode_t* bc, bool lowered) {
+    CHECK_CALL(compile_helper(text, bc));
+    lower_loop_idioms(bc);
+    ASSERT_EQm(text, bc->separator > 0 &&
+                         bc->data[bc->separator - 1].tag == I_PATTERN_LOOP,
+               lowered);
+    PASS();
+}
+
+TEST should_lower_pattern_loops() {
+    tele_bytecode_t bc;
+    pattern_loop_t loop;
+    const tele_command_view_t post = {
+        .bytecode = &bc, .start = 3, .end = BYTECODE_MAX_LENGTH
+    };
+    tele_command_view_t view;
+
+    CHECK_CALL(lower_helper("L 0 63: P I 0", &bc, true));
+    view = post;
+    view.end = bc.length;
+    ASSERT(match_pattern_loop(&view, &loop));
+    ASSERT_EQ(loop.dst, -1);
+    ASSERT_EQ(loop.dst_offset, 0);
+    ASSERT_EQ(loop.value_type, LOOP_VALUE_NUMBER);
+    ASSERT_EQ(loop.value, 0);
+
+    CHECK_CALL(lower_helper("L 0 15: PN 1 I RRAND 2 7", &bc, true));
+    view.end = bc.length;
+    ASSERT(match_pattern_loop(&view, &loop));
+    ASSERT_EQ(loop.dst, 1);
+    ASSERT_EQ(loop.value_type, LOOP_VALUE_OP);
+    ASSERT_EQ(loop.value, E_OP_RRAND);
+    ASSERT_EQ(loop.params, 2);
+    ASSERT_EQ(loop.args[0], 7);
+    ASSERT_EQ(loop.args[1], 2);
+
+    CHECK_CALL(lower_helper("L 1 3: P - I 1 PN 2 I", &bc, true));
+    view.end = bc.length;
+    ASSERT(match_pattern_loop(&view, &loop));
+    ASSERT_EQ(loop.dst_offset, -1);
+    ASSERT_EQ(loop.value_type, LOOP_VALUE_PATTERN);
+    ASSERT_EQ(loop.src, 2);
+    ASSERT_EQ(loop.value, 0);
+
+    CHECK_CALL(lower_helper("L 0 3: P I X", &bc, true));
+    CHECK_CALL(lower_helper("L 0 3: P + 2 I + I 4", &bc, true));
+    CHECK_CALL(lower_helper("L X Y: PN 0 I P I", &bc, true));
+
+    // anything else is left to the interpreter
+    CHECK_CALL(lower_helper("L 0 3: P I 0; X 1", &bc, false));
+    CHECK_CALL(lower_helper("L 0 3: P * I 2 0", &bc, false));
+    CHECK_CALL(lower_helper("L 0 3: P - 3 I 0", &bc, false));
+    CHECK_CALL(lower_helper("L 0 3: P I P.NEXT", &bc, false));
+    CHECK_CALL(lower_helper("L 0 3: PN X I 0", &bc, false));
+    CHECK_CALL(lower_helper("L 0 3: TR.PULSE I", &bc, false));
+    CHECK_CALL(lower_helper("IF 1: P I 0", &bc, false));
+
+    // the post command of a pattern loop isn't fused
+    CHECK_CALL(fuse_helper("L 0 3: PN 1 I 5", &bc));
+    ASSERT_EQ(bc.data[bc.separator - 1].tag, I_MOD);
+    ASSERT_EQ(bc.data[bc.length - 1].tag, I_OPERAND);
+    CHECK_CALL(lower_helper("L 0 3: PN 1 I 5", &bc, true));
+    fuse_bytecode(&bc, NULL);
+    ASSERT_EQ(bc.length - bc.separator, 4);
+    ASSERT_EQ(bc.data[bc.length - 1].tag, I_SET);
+
+    PASS();
+}
+
+TEST unmatched_pattern_loops_should_run_as_l() {
+    scene_state_t ss;
+    ss_init(&ss);
+    exec_state_t es;
+    es_init(&es);
+
+    // a post command that isn't a pattern loop, marked as one anyway
+    tele_bytecode_t bc;
+    CHECK_CALL(compile_helper("L 1 4: X ADD X I", &bc));
+    bc.data[bc.separator - 1].tag = I_PATTERN_LOOP;
+
+    ss.variables.x = 0;
+    process_bytecode(&ss, &es, &bc);
+    ASSERT_EQ(ss.variables.x, 10);
+    ASSERT_EQ(ss.variables.i, 4);
+
+    PASS();
+}
+
+// every pure op can be folded whatever its params are, a division by 0 (or
+// -32768 / -1) would stop the compiler rather than the command
+TEST pure_ops_should_fold_any_params() {
+    const int16_t values[] = { 0, 1, -1, INT16_MIN, INT16_MAX };
+    const uint8_t count = sizeof(values) / sizeof(values[0]);
+
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const tele_op_t *op = tele_ops[i];
+        if (!op->pure) continue;
+
+        for (uint8_t v = 0; v < count; v++) {
+            for (uint8_t p = 0; p < op->params; p++) {
+                command_state_t cs;
+                cs_init(&cs);
+                for (uint8_t j = 0; j < op->params; j++)
+                    cs_push(&cs, j == p ? values[v] : values[(v + 1) % count]);
+                op->get(op->data, NULL, NULL, &cs);
+                ASSERT_EQm(op->name, cs_stack_size(&cs), 1);
+            }
+        }
+    }
+
+    PASS();
+}
+
+TEST delayed_commands_should_be_copied() {
+    scene_state_t ss;
+    ss_init(&ss);
+    exec_state_t es;
+    es_init(&es);
+
+    // DEL must keep its own copy of the post command, as the original can be
+    // gone by the time it runs
+    tele_bytecode_t bc;
+    CHECK_CALL(compile_helper("DEL 10: X 5", &bc));
+    process_bytecode(&ss, &es, &bc);
+    CHECK_CALL(compile_helper("X 6", &bc));
+
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    ASSERT_EQ(ss.variables.x, 5);
+
+    PASS();
+}
+
+TEST scripts_should_be_compiled() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("X ADD X 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 0, 0, &cmd);
+    ss_insert_script_command(&ss, 0, 0, &cmd);
+    ASSERT_EQ(ss_get_script_bytecode(&ss, 0, 0)->length, 2);
+    ASSERT_EQ(ss_get_script_bytecode(&ss, 0, 1)->length, 2);
+
+    ss.variables.x = 0;
+    run_script(&ss, 0);
+    ASSERT_EQ(ss.variables.x, 2);
+
+    ss_delete_script_command(&ss, 0, 0);
+    ASSERT_EQ(ss_get_script_bytecode(&ss, 0, 1)->length, 0);
+
+    run_script(&ss, 0);
+    ASSERT_EQ(ss.variables.x, 3);
+
+    PASS();
+}
+
+TEST should_refuse_to_overflow_the_stack() {
+    tele_command_t cmd;
+    tele_bytecode_t bc;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+
+    CHECK_CALL(compile_helper("SCALE X SCALE 1 2 3 4 5 6 7 8", &bc));
+    ASSERT_EQ(bc.stack_depth, 8);
+
+    // not validated, as with a command saved by an older version
+    ASSERT_EQ(parse("SCALE SCALE 1 2 3 4 5 6 7 8 9", &cmd, error_msg), E_OK);
+    compile_command(&cmd, &bc);
+    ASSERT_EQ(bc.length, 0);
+    ASSERT_EQ(bc.separator, -1);
+
+    PASS();
+}
+
+SUITE(bytecode_suite) {
+    RUN_TEST(should_reverse_sub_commands);
+    RUN_TEST(should_resolve_get_and_set);
+    RUN_TEST(should_specialise_common_ops);
+    RUN_TEST(should_fold_pure_ops);
+    RUN_TEST(pure_ops_should_fold_any_params);
+    RUN_TEST(should_fuse_instructions);
+    RUN_TEST(should_separate_sub_commands);
+    RUN_TEST(should_place_post_command_after_mod);
+    RUN_TEST(should_lower_pattern_loops);
+    RUN_TEST(unmatched_pattern_loops_should_run_as_l);
+    RUN_TEST(delayed_commands_should_be_copied);
+    RUN_TEST(scripts_should_be_compiled);
+    RUN_TEST(should_refuse_to_overflow_the_stack);
+}
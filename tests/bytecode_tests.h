@@ -0,0 +1,8 @@
+#ifndef _BYTECODE_TESTS_H_
+#define _BYTECODE_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(bytecode_suite);
+
+#endif
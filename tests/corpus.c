@@ -0,0 +1,27 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "corpus.h"
+
+bool corpus_read(const char *filename,
+                 void (*fn)(const char *line, const char *filename)) {
+    FILE *f = fopen(filename, "r");
+    if (!f) return false;
+
+    char line[64];
+    bool in_script = false;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] == '#') {
+            // #1 to #8, #M and #I are scripts, #P is the patterns
+            in_script = line[1] != 'P' && line[1] != 'p';
+        }
+        else if (in_script && strlen(line)) {
+            fn(line, filename);
+        }
+    }
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,9 @@
+#ifndef _CORPUS_H_
+#define _CORPUS_H_
+
+// Reads scenes in the same format as the USB disk backups (see corpus/*.txt),
+// calling fn with every script line, returns false if the file can't be read
+bool corpus_read(const char *filename,
+                 void (*fn)(const char *line, const char *filename));
+
+#endif
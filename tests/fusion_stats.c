@@ -0,0 +1,140 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bytecode.h"
+#include "corpus.h"
+#include "teletype.h"
+
+// Reads scenes (in the same format as the USB disk backups), compiles every
+// script line and prints how often each fusion in bytecode.c is made, along
+// with the most common sequences of instructions that are left unfused. Use it
+// to decide which fusions are worth having.
+//
+// usage: fusion_stats corpus/*.txt
+
+#define MAX_SEQUENCE_LENGTH 4
+#define MAX_SEQUENCES 256
+#define TOP_SEQUENCES 20
+
+static const char *tag_names[I__LENGTH] = {
+    [I_NUMBER] = "I_NUMBER",         [I_GET] = "I_GET",
+    [I_SET] = "I_SET",               [I_MOD] = "I_MOD",
+    [I_SUB_SEP] = "I_SUB_SEP",       [I_PEEK] = "I_PEEK",
+    [I_POKE] = "I_POKE",             [I_ADD] = "I_ADD",
+    [I_SUB] = "I_SUB",               [I_EQ] = "I_EQ",
+    [I_NE] = "I_NE",                 [I_LT] = "I_LT",
+    [I_GT] = "I_GT",                 [I_SCRIPT] = "I_SCRIPT",
+    [I_PATTERN_LOOP] = "I_PATTERN_LOOP",
+    [I_ADD_TO_VAR] = "I_ADD_TO_VAR", [I_NUMBER_GET] = "I_NUMBER_GET",
+    [I_NUMBER_SET] = "I_NUMBER_SET", [I_NUMBER_POKE] = "I_NUMBER_POKE",
+    [I_OPERAND] = "I_OPERAND"
+};
+
+typedef struct {
+    uint8_t length;
+    uint8_t tags[MAX_SEQUENCE_LENGTH];
+    uint16_t count;
+} sequence_t;
+
+static sequence_t sequences[MAX_SEQUENCES];
+static uint16_t sequence_count = 0;
+static uint16_t fusion_counts[256];
+static uint32_t lines = 0;
+static uint32_t instructions_unfused = 0;
+static uint32_t instructions_fused = 0;
+static uint32_t pattern_loops = 0;
+
+static void count_sequence(const uint8_t *tags, uint8_t length) {
+    for (uint16_t i = 0; i < sequence_count; i++) {
+        if (sequences[i].length == length &&
+            memcmp(sequences[i].tags, tags, length) == 0) {
+            sequences[i].count++;
+            return;
+        }
+    }
+    if (sequence_count == MAX_SEQUENCES) return;
+    sequences[sequence_count].length = length;
+    memcpy(sequences[sequence_count].tags, tags, length);
+    sequences[sequence_count].count = 1;
+    sequence_count++;
+}
+
+// count every sequence of 2 or more instructions that doesn't cross a sub
+// command or the separator (I_OPERAND is skipped as it's never run, as is the
+// post command of a pattern loop)
+static void count_sequences(const tele_bytecode_t *bc) {
+    uint8_t tags[BYTECODE_MAX_LENGTH];
+    uint8_t length = 0;
+    for (uint8_t i = 0; i < bc->length; i++) {
+        if (bc->data[i].tag == I_PATTERN_LOOP) break;
+        if (bc->data[i].tag != I_OPERAND) tags[length++] = bc->data[i].tag;
+    }
+
+    for (uint8_t start = 0; start < length; start++) {
+        for (uint8_t len = 2; len <= MAX_SEQUENCE_LENGTH; len++) {
+            if (start + len > length) break;
+            bool valid = true;
+            for (uint8_t i = start; i < start + len; i++)
+                if (tags[i] == I_MOD || tags[i] == I_SUB_SEP) valid = false;
+            if (valid) count_sequence(&tags[start], len);
+        }
+    }
+}
+
+static void process_line(const char *line, const char *filename) {
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    error_t status = parse(line, &cmd, error_msg);
+    if (status == E_OK) status = validate(&cmd, error_msg);
+    if (status != E_OK) {
+        fprintf(stderr, "%s: %s (%s %s)\n", filename, line, tele_error(status),
+                error_msg);
+        return;
+    }
+
+    tele_bytecode_t bc;
+    compile_command_unfused(&cmd, &bc);
+    instructions_unfused += bc.length;
+    lower_loop_idioms(&bc);
+    if (bc.separator > 0 && bc.data[bc.separator - 1].tag == I_PATTERN_LOOP)
+        pattern_loops++;
+    fuse_bytecode(&bc, fusion_counts);
+    for (uint8_t i = 0; i < bc.length; i++)
+        if (bc.data[i].tag != I_OPERAND) instructions_fused++;
+    count_sequences(&bc);
+    lines++;
+}
+
+static int compare_sequences(const void *a, const void *b) {
+    return ((const sequence_t *)b)->count - ((const sequence_t *)a)->count;
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!corpus_read(argv[i], process_line))
+            fprintf(stderr, "can't open %s\n", argv[i]);
+    }
+
+    printf("%u lines, %u instructions before fusion, %u after\n\n", lines,
+           instructions_unfused, instructions_fused);
+
+    printf("L loops run as pattern loops: %u\n\n", pattern_loops);
+
+    printf("fusions made:\n");
+    for (uint8_t i = 0; i < fusion_count(); i++)
+        printf("  %-12s %5u\n", fusion_name(i), fusion_counts[i]);
+
+    printf("\nmost common unfused sequences:\n");
+    qsort(sequences, sequence_count, sizeof(sequence_t), compare_sequences);
+    for (uint16_t i = 0; i < sequence_count && i < TOP_SEQUENCES; i++) {
+        printf("  %5u  {", sequences[i].count);
+        for (uint8_t j = 0; j < sequences[i].length; j++)
+            printf(" %s%s", tag_names[sequences[i].tags[j]],
+                   j < sequences[i].length - 1 ? "," : "");
+        printf(" }\n");
+    }
+
+    return 0;
+}
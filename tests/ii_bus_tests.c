@@ -0,0 +1,224 @@
+#include "ii_bus_tests.h"
+
+#include "greatest/greatest.h"
+
+#include "ii.h"
+#include "ii_bus.h"
+#include "io_stubs.h"
+#include "teletype.h"
+#include "teletype_io.h"
+
+// the cache is off by default, the tests of it turn it on with this
+#define POLL_MS 20
+
+static uint8_t callbacks;
+static ii_status_t last_status;
+
+static void count_callback(ii_transfer_t *t) {
+    callbacks++;
+    last_status = t->status;
+}
+
+static void reset() {
+    ii_mock_reset();
+    ii_wait();
+    ii_cache_clear();
+    ii_set_poll_ms(II_POLL_MS);
+    ii_log_clear();
+    callbacks = 0;
+}
+
+TEST ii_transfers_should_call_back() {
+    reset();
+    uint8_t d[2] = { 1, 2 };
+    ASSERT(ii_submit(0x60, false, d, 2, count_callback, NULL));
+    ASSERT(ii_busy());
+    ASSERT_EQ(callbacks, 0);
+
+    ii_poll(tele_get_ticks());
+    ASSERT_FALSE(ii_busy());
+    ASSERT_EQ(callbacks, 1);
+    ASSERT_EQ(last_status, II_OK);
+    ASSERT_EQ(ii_log.count, 1);
+    PASS();
+}
+
+TEST ii_transfers_should_wait_for_the_bus() {
+    reset();
+    ii_mock_latency = 10;
+    uint8_t d[2] = { 1, 2 };
+    ii_submit(0x60, false, d, 2, count_callback, NULL);
+    ii_submit(0x60, false, d, 2, count_callback, NULL);
+
+    // only one transfer is on the bus at once
+    ii_poll(tele_get_ticks());
+    ASSERT_EQ(ii_log.count, 1);
+    ASSERT_EQ(callbacks, 0);
+
+    const uint32_t start = tele_get_ticks();
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(callbacks, 2);
+    ASSERT(tele_get_ticks() - start >= 10);
+    PASS();
+}
+
+TEST ii_transfers_should_time_out() {
+    reset();
+    ii_mock_missing = true;
+    uint8_t d[2] = { 1, 2 };
+    ii_submit(0x60, false, d, 2, count_callback, NULL);
+
+    const uint32_t start = tele_get_ticks();
+    ii_wait();
+    ASSERT_EQ(callbacks, 1);
+    ASSERT_EQ(last_status, II_TIMEOUT);
+    ASSERT(tele_get_ticks() - start >= II_TIMEOUT_MS * TICKS_PER_MS);
+
+    // there's only room for so many transfers
+    for (int i = 0; i < II_TRANSFER_QUEUE_LENGTH; i++)
+        ASSERT(ii_submit(0x60, false, d, 2, NULL, NULL));
+    ASSERT_FALSE(ii_submit(0x60, false, d, 2, NULL, NULL));
+    ii_wait();
+    PASS();
+}
+
+TEST ii_reads_should_return_data() {
+    reset();
+    ii_mock_latency = 3;
+    ii_mock_response[0] = 0x12;
+    ii_mock_response[1] = 0x34;
+    uint8_t d[2] = { 0, 0 };
+    ii_rx(0x60, d, 2);
+    ASSERT_EQ(d[0], 0x12);
+    ASSERT_EQ(d[1], 0x34);
+
+    // or leave it as 0 if the follower isn't there
+    ii_mock_missing = true;
+    d[0] = d[1] = 0;
+    ii_rx(0x60, d, 2);
+    ASSERT_EQ(d[0], 0);
+    ASSERT_EQ(d[1], 0);
+    PASS();
+}
+
+static int16_t read_helper(scene_state_t *ss, const char *text) {
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse(text, &cmd, error_msg);
+    return run_command(ss, &cmd).value;
+}
+
+TEST ii_reads_from_scripts() {
+    reset();
+    ii_mock_latency = 20;
+    ii_mock_response[0] = 0x01;
+    ii_mock_response[1] = 0x02;
+
+    scene_state_t ss;
+    ss_init(&ss);
+    ASSERT_EQ(read_helper(&ss, "CV 5"), 0x0102);
+    ASSERT_EQ(read_helper(&ss, "II.POLL 20; CV 5"), 0x0102);
+
+    ii_mock_missing = true;
+    ASSERT_EQ(read_helper(&ss, "II.POLL 0; CV 5"), 0);
+
+    reset();
+    PASS();
+}
+
+TEST ii_reads_should_be_cached() {
+    reset();
+    scene_state_t ss;
+    ss_init(&ss);
+
+    // only once a scene turns the cache on
+    ii_mock_response[1] = 1;
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 1);
+    ii_mock_response[1] = 2;
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 2);
+    ASSERT_EQ(ii_log.count, 2);
+    ii_log_clear();
+    ASSERT_EQ(read_helper(&ss, "II.POLL 20; II.POLL"), POLL_MS);
+
+    // the first read is made straight away
+    ii_mock_response[1] = 1;
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 1);
+    ASSERT_EQ(ii_log.count, 1);
+
+    // then it comes from the cache
+    ii_mock_response[1] = 2;
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 1);
+    ASSERT_EQ(ii_log.count, 1);
+
+    // until it's refreshed in the background
+    const uint32_t now = tele_get_ticks();
+    ii_poll(now + POLL_MS * TICKS_PER_MS);
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 2);
+    ASSERT_EQ(ii_log.count, 2);
+
+    // or by II.REFRESH
+    ii_mock_response[1] = 3;
+    ASSERT_EQ(read_helper(&ss, "II.REFRESH; TI.IN 1"), 3);
+
+    // a write to the follower means it's read straight away again
+    ii_mock_response[1] = 4;
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 3);
+    ASSERT_EQ(read_helper(&ss, "TI.IN.INIT 1; TI.IN 1"), 4);
+
+    // each input is cached separately
+    ii_mock_response[1] = 5;
+    ASSERT_EQ(read_helper(&ss, "TI.PARAM 1"), 5);
+    ASSERT_EQ(read_helper(&ss, "TI.IN 1"), 4);
+
+    // changing II.POLL or loading a scene forgets what was cached
+    ii_mock_response[1] = 6;
+    ASSERT_EQ(read_helper(&ss, "II.POLL 0; II.POLL 20; TI.IN 1"), 6);
+    ii_mock_response[1] = 7;
+    ASSERT_EQ(read_helper(&ss, "SCENE 1; TI.IN 1"), 7);
+
+    reset();
+    PASS();
+}
+
+TEST ii_transfers_should_know_their_script() {
+    reset();
+    scene_state_t ss;
+    ss_init(&ss);
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("TO.TR 1 1; TI.IN 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 2, 0, &cmd);
+    ii_set_poll_ms(POLL_MS);
+
+    // including the scripts it calls
+    read_helper(&ss, "TO.TR 1 0");
+    run_script(&ss, 2);
+    read_helper(&ss, "SCRIPT 3");
+
+    // which are sent as soon as each has finished
+    ASSERT_FALSE(ii_busy());
+    ASSERT_EQ(ii_log.count, 4);
+    ASSERT_EQ(ii_log.sources[0], -1);
+    ASSERT_EQ(ii_log.sources[1], 2);
+    ASSERT_EQ(ii_log.sources[2], 2);
+    ASSERT_EQ(ii_log.sources[3], -1);
+
+    // the cache is refreshed outside of any script
+    ii_poll(tele_get_ticks() + POLL_MS * TICKS_PER_MS);
+    ASSERT_EQ(ii_log.count, 5);
+    ASSERT_EQ(ii_log.sources[4], II_SOURCE_NONE);
+
+    reset();
+    PASS();
+}
+
+SUITE(ii_bus_suite) {
+    RUN_TEST(ii_transfers_should_call_back);
+    RUN_TEST(ii_transfers_should_wait_for_the_bus);
+    RUN_TEST(ii_transfers_should_time_out);
+    RUN_TEST(ii_reads_should_return_data);
+    RUN_TEST(ii_reads_from_scripts);
+    RUN_TEST(ii_reads_should_be_cached);
+    RUN_TEST(ii_transfers_should_know_their_script);
+}
@@ -0,0 +1,147 @@
+#include "ii_sim_tests.h"
+
+#include <string.h>
+
+#include "greatest/greatest.h"
+
+#include "ii.h"
+#include "ii_sim.h"
+#include "ops/telex.h"
+
+static void init(uint32_t clock_hz) {
+    ii_sim_config_t config;
+    ii_sim_default_config(&config);
+    config.clock_hz = clock_hz;
+    config.transfer_us = 0;
+    ii_sim_init(&config);
+}
+
+static ii_status_t transfer(uint8_t addr, bool read, uint8_t *data, uint8_t l,
+                            uint64_t now, uint64_t *done) {
+    ii_transfer_t t = {.addr = addr, .read = read, .l = l, .source = 0 };
+    if (!read) memcpy(t.data, data, l);
+    const ii_status_t status = ii_sim_run(&t, now, done);
+    if (read) memcpy(data, t.data, l);
+    return status;
+}
+
+TEST ii_sim_transfers_should_take_time() {
+    // a start bit, 5 bytes of 9 bits and a stop bit
+    init(100000);
+    ASSERT_EQ(ii_sim_transfer_time(4), 470);
+    init(400000);
+    ASSERT_EQ(ii_sim_transfer_time(4), 118);
+
+    // one at a time
+    uint8_t d[4] = { TO_TR, 0, 0, 1 };
+    uint64_t done;
+    ASSERT_EQ(transfer(TO, false, d, 4, 1000, &done), II_OK);
+    ASSERT_EQ(done, 1118);
+    ASSERT_EQ(transfer(TO, false, d, 4, 1000, &done), II_OK);
+    ASSERT_EQ(done, 1236);
+
+    ii_sim_stats_t s = ii_sim_source_stats(0);
+    ASSERT_EQ(s.transfers, 2);
+    ASSERT_EQ(s.bytes, 10);
+    ASSERT_EQ(s.busy, 236);
+    PASS();
+}
+
+TEST ii_sim_followers_should_answer_gets() {
+    init(100000);
+    uint64_t done;
+
+    // from the last value set
+    uint8_t set[4] = { II_KR_POS, 1, 2, 3 };
+    transfer(II_KR_ADDR, false, set, 4, 0, &done);
+    set[3] = 4;
+    transfer(II_KR_ADDR, false, set, 4, 0, &done);
+    uint8_t get[3] = { II_KR_POS | II_GET, 1, 2 };
+    uint8_t d[2] = { 0, 0 };
+    transfer(II_KR_ADDR, false, get, 3, 0, &done);
+    transfer(II_KR_ADDR, true, d, 1, 0, &done);
+    ASSERT_EQ(d[0], 4);
+
+    // with the value's bytes in order
+    uint8_t cv[4] = { II_ANSIBLE_CV, 1, 0x12, 0x34 };
+    transfer(II_ANSIBLE_ADDR + 2, false, cv, 4, 0, &done);
+    get[0] = II_ANSIBLE_CV | II_GET;
+    get[1] = 1;
+    transfer(II_ANSIBLE_ADDR + 2, false, get, 2, 0, &done);
+    transfer(II_ANSIBLE_ADDR + 2, true, d, 2, 0, &done);
+    ASSERT_EQ(d[0], 0x12);
+    ASSERT_EQ(d[1], 0x34);
+
+    // or 0 if it's never been set
+    get[1] = 2;
+    transfer(II_ANSIBLE_ADDR + 2, false, get, 2, 0, &done);
+    transfer(II_ANSIBLE_ADDR + 2, true, d, 2, 0, &done);
+    ASSERT_EQ(d[0], 0);
+    ASSERT_EQ(d[1], 0);
+    PASS();
+}
+
+TEST ii_sim_txi_should_read_inputs() {
+    init(100000);
+    ii_sim_set_input(TI + 1, 4, 1000);
+    uint64_t done;
+
+    uint8_t port = 4;
+    uint8_t d[2];
+    transfer(TI + 1, false, &port, 1, 0, &done);
+    transfer(TI + 1, true, d, 2, 0, &done);
+    ASSERT_EQ((d[0] << 8) + d[1], 1000);
+
+    // quantized to the nearest semitone, 7 * 16384 / 120
+    port = 4 + 8;
+    transfer(TI + 1, false, &port, 1, 0, &done);
+    transfer(TI + 1, true, d, 2, 0, &done);
+    ASSERT_EQ((d[0] << 8) + d[1], 956);
+
+    // or as a note number
+    port = 4 + 16;
+    transfer(TI + 1, false, &port, 1, 0, &done);
+    transfer(TI + 1, true, d, 2, 0, &done);
+    ASSERT_EQ((d[0] << 8) + d[1], 7);
+    PASS();
+}
+
+TEST ii_sim_missing_followers_should_fail() {
+    init(100000);
+    uint64_t done;
+    uint8_t d[4] = { TO_TR, 0, 0, 1 };
+    ii_sim_connect(TO, false);
+    ASSERT_EQ(transfer(TO, false, d, 4, 0, &done), II_ERROR);
+
+    // after just the address
+    ASSERT_EQ(done, ii_sim_transfer_time(0));
+    ASSERT_EQ(ii_sim_source_stats(0).errors, 1);
+
+    ii_sim_connect(TO, true);
+    ASSERT_EQ(transfer(TO, false, d, 4, 0, &done), II_OK);
+    PASS();
+}
+
+TEST ii_sim_should_flag_ticks_over_budget() {
+    // 10 ms ticks, with a budget of 80%, at 470 us a transfer 17 fit
+    init(100000);
+    uint8_t d[4] = { TO_TR, 0, 0, 1 };
+    uint64_t done;
+    for (int i = 0; i < 17; i++) transfer(TO, false, d, 4, 0, &done);
+    ASSERT_EQ(ii_sim_ticks_over_budget(), 0);
+    transfer(TO, false, d, 4, 0, &done);
+    ASSERT_EQ(ii_sim_ticks_over_budget(), 1);
+
+    // the next tick starts afresh
+    for (int i = 0; i < 4; i++) transfer(TO, false, d, 4, 10000, &done);
+    ASSERT_EQ(ii_sim_ticks_over_budget(), 1);
+    PASS();
+}
+
+SUITE(ii_sim_suite) {
+    RUN_TEST(ii_sim_transfers_should_take_time);
+    RUN_TEST(ii_sim_followers_should_answer_gets);
+    RUN_TEST(ii_sim_txi_should_read_inputs);
+    RUN_TEST(ii_sim_missing_followers_should_fail);
+    RUN_TEST(ii_sim_should_flag_ticks_over_budget);
+}
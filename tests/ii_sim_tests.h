@@ -0,0 +1,8 @@
+#ifndef _II_SIM_TESTS_H_
+#define _II_SIM_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(ii_sim_suite);
+
+#endif
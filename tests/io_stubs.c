@@ -0,0 +1,94 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "io_stubs.h"
+#include "teletype_io.h"
+
+// the hardware side of teletype isn't needed for the tests or the benchmark
+
+void tele_metro_updated() {}
+
+ii_log_t ii_log;
+uint32_t ii_mock_latency = 0;
+bool ii_mock_missing = false;
+uint8_t ii_mock_response[II_TX_MAX_LENGTH];
+
+static uint32_t ticks = 0;
+static ii_transfer_t *ii_mock_transfer = NULL;
+static uint32_t ii_mock_due = 0;
+
+void ii_log_clear() {
+    ii_log.count = 0;
+}
+
+void ii_mock_reset() {
+    ii_mock_latency = 0;
+    ii_mock_missing = false;
+    memset(ii_mock_response, 0, sizeof(ii_mock_response));
+    ii_mock_transfer = NULL;
+}
+
+static void ii_mock_finish() {
+    ii_transfer_t *t = ii_mock_transfer;
+    ii_mock_transfer = NULL;
+    if (t->read) memcpy(t->data, ii_mock_response, t->l);
+    ii_transfer_done(t, II_OK);
+}
+
+uint32_t tele_get_ticks() {
+    if (ii_mock_transfer) {
+        ticks++;
+        if (!ii_mock_missing && ticks >= ii_mock_due) ii_mock_finish();
+    }
+    return ticks;
+}
+void tele_tr(uint8_t i, int16_t v) {}
+void tele_cv(uint8_t i, int16_t v, uint8_t s) {}
+void tele_cv_slew(uint8_t i, int16_t v) {}
+void tele_has_delays(bool i) {}
+void tele_has_stack(bool i) {}
+void tele_cv_off(uint8_t i, int16_t v) {}
+
+void tele_ii_start(ii_transfer_t *t) {
+    if (!t->read && ii_log.count < II_LOG_LENGTH) {
+        ii_log.sources[ii_log.count] = t->source;
+        ii_tx_message_t *m = &ii_log.messages[ii_log.count++];
+        m->addr = t->addr;
+        m->l = t->l;
+        memcpy(m->data, t->data, t->l);
+    }
+
+    ii_mock_transfer = t;
+    ii_mock_due = ticks + ii_mock_latency;
+    if (ii_mock_latency == 0 && !ii_mock_missing) ii_mock_finish();
+}
+
+void tele_scene(uint8_t i) {}
+void tele_pattern_updated() {}
+
+// the pattern banks are kept in memory so that P.BANK can be tested
+static scene_pattern_t pattern_banks[PATTERN_BANK_COUNT][PATTERN_COUNT];
+static bool pattern_banks_ready = false;
+
+static void pattern_banks_init() {
+    if (pattern_banks_ready) return;
+    for (uint8_t i = 0; i < PATTERN_BANK_COUNT; i++)
+        ss_pattern_bank_init(pattern_banks[i]);
+    pattern_banks_ready = true;
+}
+
+void tele_pattern_bank_read(uint8_t bank, scene_pattern_t *patterns) {
+    pattern_banks_init();
+    memcpy(patterns, pattern_banks[bank], sizeof(pattern_banks[bank]));
+}
+
+void tele_pattern_bank_write(uint8_t bank, const scene_pattern_t *patterns) {
+    pattern_banks_init();
+    memcpy(pattern_banks[bank], patterns, sizeof(pattern_banks[bank]));
+}
+void tele_kill() {}
+void tele_mute() {}
+bool tele_get_input_state(uint8_t n) {
+    return false;
+}
@@ -0,0 +1,31 @@
+#ifndef _IO_STUBS_H_
+#define _IO_STUBS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ii_bus.h"
+
+// the ii writes sent by tele_ii_start are recorded, along with the script
+// that queued each, so the tests can check them
+#define II_LOG_LENGTH 16
+
+typedef struct {
+    ii_tx_message_t messages[II_LOG_LENGTH];
+    int8_t sources[II_LOG_LENGTH];
+    uint8_t count;
+} ii_log_t;
+
+extern ii_log_t ii_log;
+void ii_log_clear(void);
+
+// each transfer takes ii_mock_latency ticks to finish, the clock only moves on
+// while a transfer is on the bus (as the ii engine calls tele_get_ticks while
+// it waits), with ii_mock_missing set transfers never finish, reads return
+// ii_mock_response
+extern uint32_t ii_mock_latency;
+extern bool ii_mock_missing;
+extern uint8_t ii_mock_response[II_TX_MAX_LENGTH];
+void ii_mock_reset(void);
+
+#endif
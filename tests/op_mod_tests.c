@@ -29,6 +29,20 @@ TEST unique_mods() {
     PASS();
 }
 
+// Check the generated op table matches the op definitions (if this fails run
+// 'utils/op_enums.py')
+TEST op_table_matches_ops() {
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const tele_op_t *op = tele_ops[i];
+        const uint8_t flags = tele_op_flags[i];
+        ASSERT_EQm(op->name, tele_op_params[i], op->params);
+        ASSERT_EQm(op->name, !!(flags & OP_FLAG_RETURNS), op->returns);
+        ASSERT_EQm(op->name, !!(flags & OP_FLAG_SET), op->set != NULL);
+        ASSERT_EQm(op->name, !!(flags & OP_FLAG_PURE), op->pure);
+    }
+    PASS();
+}
+
 // Check every op manipulates the stack correctly
 TEST op_stack_size() {
     for (size_t i = 0; i < E_OP__LENGTH; i++) {
@@ -105,11 +119,14 @@ TEST mod_stack_size() {
         for (int j = 0; j < mod->params + stack_extra; j++) cs_push(&cs, 0);
 
         // execute func
-        const tele_command_t sub_command = {.length = 1,
-                                            .separator = 0,
-                                            .data = { {.tag = OP,
-                                                       .value = E_OP_A } } };
-        mod->func(&ss, &es, &cs, &sub_command);
+        const tele_bytecode_t sub_command = {.length = 1,
+                                             .separator = -1,
+                                             .data = { {.tag = I_GET,
+                                                        .value = E_OP_A } } };
+        const tele_command_view_t sub_command_view = {
+            .bytecode = &sub_command, .start = 0, .end = 1
+        };
+        mod->func(&ss, &es, &cs, &sub_command_view);
 
         // check that the stack has the correct number of items in it
         ASSERT_EQm(mod->name, cs_stack_size(&cs), stack_extra);
@@ -120,6 +137,7 @@ TEST mod_stack_size() {
 SUITE(op_mod_suite) {
     RUN_TEST(unique_ops);
     RUN_TEST(unique_mods);
+    RUN_TEST(op_table_matches_ops);
     RUN_TEST(op_stack_size);
     RUN_TEST(mod_stack_size);
 }
@@ -177,6 +177,40 @@ TEST parser_test_sub_commands() {
     PASS();
 }
 
+TEST parser_test_stack_depth() {
+    // the inner SCALE needs all 9 numbers on the stack at once
+    ASSERT_EQ(parse_and_validate_helper("SCALE SCALE 1 2 3 4 5 6 7 8 9"),
+              E_STACK_OVERFLOW);
+    ASSERT_EQ(parse_and_validate_helper("SCALE X SCALE 1 2 3 4 5 6 7 8"), E_OK);
+    PASS();
+}
+
+TEST parser_test_wide_numbers() {
+    // numbers either side of the packed range, and the ends of int16_t
+    const int16_t numbers[] = { 0,    -1,    4095,   4096,
+                                -4096, -4097, 32767, -32768 };
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++) {
+        char text[16];
+        sprintf(text, "X %d", numbers[i]);
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        ASSERT_EQm(text, parse(text, &cmd, error_msg), E_OK);
+        ASSERT_EQm(text, command_tag(&cmd, 1), NUMBER);
+        ASSERT_EQm(text, command_value(&cmd, 1), numbers[i]);
+
+        char out[32];
+        print_command(&cmd, out);
+        ASSERT_STR_EQ(text, out);
+    }
+
+    // every number of a command can be wide
+    ASSERT_EQ(parse_and_validate_helper("SCALE 5000 6000 7000 8000 9000"), E_OK);
+    ASSERT_EQ(parse_and_validate_helper("SCALE 5000 5001 5002 5003 SCALE "
+                                        "5004 5005 5006 5007 5008"),
+              E_OK);
+    PASS();
+}
+
 // This test asserts that the parser always returns the correct op, it does this
 // by starting with the op in question, extracting the name and running that
 // through the parser. Then asserting that only 1 op is returned in
@@ -190,8 +224,8 @@ TEST parser_should_return_op() {
         error_t result = parse(text, &cmd, error_msg);
         ASSERT_EQm(text, result, E_OK);
         ASSERT_EQm(text, cmd.length, 1);
-        ASSERT_EQm(text, cmd.data[0].tag, OP);
-        ASSERT_EQm(text, cmd.data[0].value, (int16_t)i);
+        ASSERT_EQm(text, command_tag(&cmd, 0), OP);
+        ASSERT_EQm(text, command_value(&cmd, 0), (int16_t)i);
     }
     PASS();
 }
@@ -206,8 +240,8 @@ TEST parser_should_return_mod() {
         error_t result = parse(text, &cmd, error_msg);
         ASSERT_EQm(text, result, E_OK);
         ASSERT_EQm(text, cmd.length, 1);
-        ASSERT_EQm(text, cmd.data[0].tag, MOD);
-        ASSERT_EQm(text, cmd.data[0].value, (int16_t)i);
+        ASSERT_EQm(text, command_tag(&cmd, 0), MOD);
+        ASSERT_EQm(text, command_value(&cmd, 0), (int16_t)i);
     }
     PASS();
 }
@@ -235,6 +269,8 @@ TEST print_command_corpus_should_be_unchanged() {
 SUITE(parser_suite) {
     RUN_TEST(should_parse_and_validate);
     RUN_TEST(parser_test_sub_commands);
+    RUN_TEST(parser_test_stack_depth);
+    RUN_TEST(parser_test_wide_numbers);
     RUN_TEST(parser_should_return_op);
     RUN_TEST(parser_should_return_mod);
     RUN_TEST(print_command_corpus_should_be_unchanged);
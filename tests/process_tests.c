@@ -6,6 +6,9 @@
 
 #include "greatest/greatest.h"
 
+#include "ii.h"
+#include "io_stubs.h"
+#include "ops/telex.h"
 #include "teletype.h"
 // runs multiple lines of commands and then asserts that the final answer is
 // correct (allows contiuation of state)
@@ -150,6 +153,49 @@ TEST test_L() {
     PASS();
 }
 
+TEST test_L_pattern() {
+    // these are all run as pattern loops, and must give the same result as
+    // interpreting them would
+    char* test1[2] = { "L 0 63: P I 7", "P 63" };
+    CHECK_CALL(process_helper(2, test1, 7));
+
+    char* test2[2] = { "L 0 63: P I 7", "I" };
+    CHECK_CALL(process_helper(2, test2, 63));
+
+    char* test3[3] = { "L 3 0: P I I", "I", "P 1" };
+    CHECK_CALL(process_helper(3, test3, 1));
+
+    char* test4[3] = { "X 4", "L 0 3: PN 2 + I 1 X", "PN 2 4" };
+    CHECK_CALL(process_helper(3, test4, 4));
+
+    char* test5[3] = { "L 0 3: P I I", "L 1 3: P I P - I 1", "P 3" };
+    CHECK_CALL(process_helper(3, test5, 0));
+
+    char* test6[3] = { "P.L 4", "L -4 -1: P I 9", "P 0" };
+    CHECK_CALL(process_helper(3, test6, 9));
+
+    char* test7[2] = { "L 60 70: P I I", "P 63" };
+    CHECK_CALL(process_helper(2, test7, 70));
+
+    char* test8[2] = { "L 0 15: PN 1 I RRAND 5 5", "PN 1 15" };
+    CHECK_CALL(process_helper(2, test8, 5));
+
+    // random values are taken in the same order as by the interpreter (the
+    // sub command stops the 2nd line from being a pattern loop)
+    scene_state_t ss;
+    ss_init(&ss);
+    char* test9[2] = { "L 0 15: PN 1 I RAND 100", "1" };
+    srand(3);
+    CHECK_CALL(process_helper_state(&ss, 2, test9, 1));
+    char* test10[2] = { "L 0 15: PN 2 I RAND 100; X", "1" };
+    srand(3);
+    CHECK_CALL(process_helper_state(&ss, 2, test10, 1));
+    for (int16_t i = 0; i < 16; i++)
+        ASSERT_EQ(ss_get_pattern_val(&ss, 1, i), ss_get_pattern_val(&ss, 2, i));
+
+    PASS();
+}
+
 TEST test_O() {
     scene_state_t ss;
     ss_init(&ss);
@@ -206,6 +252,98 @@ TEST test_PN() {
     PASS();
 }
 
+TEST test_P_bulk() {
+    // P.PUSH leaves P 0 to P 3 as 3 1 4 2, with a length of 4
+    char* fill = "P.PUSH 3; P.PUSH 1; P.PUSH 4; P.PUSH 2";
+
+    char* test1[2] = { fill, "P.SUM" };
+    CHECK_CALL(process_helper(2, test1, 10));
+
+    char* test2[2] = { fill, "P.MIN" };
+    CHECK_CALL(process_helper(2, test2, 1));
+
+    char* test3[2] = { fill, "P.MAX" };
+    CHECK_CALL(process_helper(2, test3, 4));
+
+    char* test4[2] = { fill, "P.FIND 4" };
+    CHECK_CALL(process_helper(2, test4, 2));
+
+    char* test5[2] = { fill, "P.FIND 5" };
+    CHECK_CALL(process_helper(2, test5, -1));
+
+    char* test6[3] = { fill, "P.REV", "P 0" };
+    CHECK_CALL(process_helper(3, test6, 2));
+
+    char* test7[3] = { fill, "P.ROT 1", "P 1" };
+    CHECK_CALL(process_helper(3, test7, 3));
+
+    char* test8[3] = { fill, "P.ROT -5", "P 0" };
+    CHECK_CALL(process_helper(3, test8, 1));
+
+    char* test9[3] = { fill, "P.ADD 10", "P.SUM" };
+    CHECK_CALL(process_helper(3, test9, 50));
+
+    char* test10[3] = { fill, "P.SCALE 0 10 0 100", "P 2" };
+    CHECK_CALL(process_helper(3, test10, 40));
+
+    // only the values between P.START and P.END are used
+    char* test11[3] = { fill, "P.START 1; P.END 2", "P.SUM" };
+    CHECK_CALL(process_helper(3, test11, 5));
+
+    char* test12[4] = { fill, "P.START 1; P.END 2", "P.REV", "P 1" };
+    CHECK_CALL(process_helper(4, test12, 4));
+
+    char* test13[4] = { fill, "P.START 1; P.END 2", "P.SHUF", "P 3" };
+    CHECK_CALL(process_helper(4, test13, 2));
+
+    char* test14[3] = { fill, "P.SHUF", "P.SUM" };
+    CHECK_CALL(process_helper(3, test14, 10));
+
+    // an empty pattern is left alone
+    char* test15[2] = { "P 0 5; P.ADD 1", "P 0" };
+    CHECK_CALL(process_helper(2, test15, 5));
+
+    char* test16[1] = { "P.MAX" };
+    CHECK_CALL(process_helper(1, test16, 0));
+
+    char* test17[3] = { fill, "P.N 1; PN.ADD 0 1", "PN.SUM 0" };
+    CHECK_CALL(process_helper(3, test17, 14));
+
+    char* test18[3] = { fill, "P.N 1; PN.ROT 0 2", "PN.FIND 0 3" };
+    CHECK_CALL(process_helper(3, test18, 2));
+
+    PASS();
+}
+
+TEST test_P_BANK() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    char* test1[3] = { "P 0 5", "P.BANK 1", "P 0" };
+    CHECK_CALL(process_helper_state(&ss, 3, test1, 0));
+    ASSERT_FALSE(ss.pattern_bank_changed);
+
+    char* test2[3] = { "P 0 7", "P.BANK 0", "P 0" };
+    CHECK_CALL(process_helper_state(&ss, 3, test2, 5));
+
+    char* test3[2] = { "P.BANK 1", "P 0" };
+    CHECK_CALL(process_helper_state(&ss, 2, test3, 7));
+
+    char* test4[2] = { "P.BANK 9", "P.BANK" };
+    CHECK_CALL(process_helper_state(&ss, 2, test4, PATTERN_BANK_COUNT - 1));
+
+    // anything that changes a pattern means it has to be written back
+    char* test5[2] = { "P.NEXT", "P.BANK" };
+    CHECK_CALL(process_helper_state(&ss, 2, test5, PATTERN_BANK_COUNT - 1));
+    ASSERT(ss.pattern_bank_changed);
+
+    char* test6[3] = { "P.BANK 1; P.L 2; P.BANK 0", "P.BANK 1; P.REV", "P 1" };
+    CHECK_CALL(process_helper_state(&ss, 3, test6, 7));
+    ASSERT(ss.pattern_bank_changed);
+
+    PASS();
+}
+
 TEST test_Q() {
     scene_state_t ss;
     ss_init(&ss);
@@ -243,6 +381,47 @@ TEST test_Q() {
         CHECK_CALL(process_helper_state(&ss, 1, test6, 5));
     }
 
+    // the sum for Q.AVG doesn't overflow
+    char* test7[3] = { "Q.N 4", "Q.AVG 20000", "Q.AVG" };
+    CHECK_CALL(process_helper_state(&ss, 3, test7, 20000));
+
+    char* test8[5] = { "Q.N 3", "Q 7", "Q -2", "Q.MIN", "Q.MAX" };
+    CHECK_CALL(process_helper_state(&ss, 4, test8, -2));
+    CHECK_CALL(process_helper_state(&ss, 1, test8 + 4, 20000));
+
+    PASS();
+}
+
+TEST test_Q_window() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    // Q.AVG, Q.MIN and Q.MAX match a brute force search of the window, for
+    // every length, including after the length changes
+    int16_t history[Q_LENGTH] = { 0 };  // newest first
+    srand(1);
+    for (int i = 0; i < 4000; i++) {
+        if (i % 100 == 0) ss_queue_set_len(&ss, 1 + rand() % Q_LENGTH);
+
+        const int16_t value = rand() % 2000 - 1000;
+        ss_queue_push(&ss, value);
+        memmove(&history[1], &history[0], sizeof(int16_t) * (Q_LENGTH - 1));
+        history[0] = value;
+
+        int32_t sum = 0;
+        int16_t min = history[0], max = history[0];
+        for (int j = 0; j < ss.queue.len; j++) {
+            sum += history[j];
+            if (history[j] < min) min = history[j];
+            if (history[j] > max) max = history[j];
+        }
+        ASSERT_EQ(ss_queue_get(&ss, ss.queue.len - 1),
+                  history[ss.queue.len - 1]);
+        ASSERT_EQ(ss_queue_avg(&ss), sum / ss.queue.len);
+        ASSERT_EQ(ss_queue_min(&ss), min);
+        ASSERT_EQ(ss_queue_max(&ss), max);
+    }
+
     PASS();
 }
 
@@ -273,6 +452,509 @@ TEST test_sub_commands() {
     PASS();
 }
 
+// sets the lines of a script
+TEST script_helper(scene_state_t* ss, size_t script, size_t n, char* lines[]) {
+    for (size_t i = 0; i < n; i++) {
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        ASSERT_EQm(lines[i], parse(lines[i], &cmd, error_msg), E_OK);
+        ASSERT_EQm(lines[i], validate(&cmd, error_msg), E_OK);
+        ss_overwrite_script_command(ss, script, i, &cmd);
+    }
+    PASS();
+}
+
+TEST test_SCRIPT() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    // the caller carries on where it left off once the script has finished
+    char* script1[1] = { "X ADD X 1" };
+    char* script2[2] = { "SCRIPT 1; X MUL X 10", "X ADD X 2" };
+    CHECK_CALL(script_helper(&ss, 0, 1, script1));
+    CHECK_CALL(script_helper(&ss, 1, 2, script2));
+    char* test1[2] = { "X 0; SCRIPT 2", "X" };
+    CHECK_CALL(process_helper_state(&ss, 2, test1, 12));
+
+    // including from inside a loop, even if the script changes I
+    char* script3[1] = { "Y ADD Y I; I 0" };
+    CHECK_CALL(script_helper(&ss, 2, 1, script3));
+    char* test2[3] = { "Y 0", "L 1 4: SCRIPT 3", "Y" };
+    CHECK_CALL(process_helper_state(&ss, 3, test2, 10));
+
+    // recursion stops once there are EXEC_DEPTH frames (the command counts
+    // as one of them)
+    char* script4[1] = { "Z ADD Z 1; SCRIPT 4" };
+    CHECK_CALL(script_helper(&ss, 3, 1, script4));
+    char* test3[2] = { "Z 0; SCRIPT 4", "Z" };
+    CHECK_CALL(process_helper_state(&ss, 2, test3, EXEC_DEPTH - 1));
+
+    PASS();
+}
+
+TEST test_SCRIPT_inlining() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    // lines that only call another script are replaced with its lines
+    char* script1[2] = { "SCRIPT 5", "SCRIPT 5" };
+    char* script5[2] = { "X ADD X 1", "X MUL X 2" };
+    CHECK_CALL(script_helper(&ss, 0, 2, script1));
+    CHECK_CALL(script_helper(&ss, 4, 2, script5));
+    ASSERT_EQ(ss_get_inlined_script_len(&ss, 0), 4);
+    char* test1[2] = { "X 0; SCRIPT 1", "X" };
+    CHECK_CALL(process_helper_state(&ss, 2, test1, 6));
+
+    // and are kept up to date when the called script changes
+    ss_delete_script_command(&ss, 4, 1);
+    ASSERT_EQ(ss_get_inlined_script_len(&ss, 0), 2);
+    CHECK_CALL(process_helper_state(&ss, 2, test1, 2));
+
+    // recursive calls are left alone
+    char* script2[1] = { "SCRIPT 3" };
+    char* script3[1] = { "SCRIPT 2" };
+    CHECK_CALL(script_helper(&ss, 1, 1, script2));
+    CHECK_CALL(script_helper(&ss, 2, 1, script3));
+    ASSERT_EQ(ss_get_inlined_script_len(&ss, 1), 1);
+    ASSERT_EQ(ss_get_inlined_script_bytecode(&ss, 1, 0),
+              ss_get_script_bytecode(&ss, 2, 0));
+
+    // if there isn't room, the remaining calls are made at run time
+    char* script6[6] = { "SCRIPT 7", "SCRIPT 7", "SCRIPT 7",
+                         "SCRIPT 7", "SCRIPT 7", "SCRIPT 7" };
+    char* script7[6] = { "Y ADD Y 1", "Y ADD Y 1", "Y ADD Y 1",
+                         "Y ADD Y 1", "Y ADD Y 1", "Y ADD Y 1" };
+    CHECK_CALL(script_helper(&ss, 5, 6, script6));
+    CHECK_CALL(script_helper(&ss, 6, 6, script7));
+    ASSERT(ss_get_inlined_script_len(&ss, 5) <= SCRIPT_MAX_INLINED_COMMANDS);
+    char* test2[2] = { "Y 0; SCRIPT 6", "Y" };
+    CHECK_CALL(process_helper_state(&ss, 2, test2, 36));
+
+    PASS();
+}
+
+TEST test_DEL() {
+    scene_state_t ss;
+    ss_init(&ss);
+    char* x[1] = { "X" };
+
+    // delays run in the order they're due, or were added if due together
+    char* test1[5] = { "X 0", "DEL 30: X 3", "DEL 10: X 1", "DEL 10: X 2",
+                       "X" };
+    CHECK_CALL(process_helper_state(&ss, 5, test1, 0));
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 2));
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 2));
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 3));
+    ASSERT_EQ(ss.delay.count, 0);
+
+    // repeats of the same command share storage, so many more than
+    // DELAY_COMMANDS can be waiting
+    char* test2[2] = { "DEL 10: X ADD X 1", "X" };
+    for (int16_t i = 0; i < 40; i++)
+        CHECK_CALL(process_helper_state(&ss, 2, test2, 3));
+    ASSERT_EQ(ss.delay.count, 40);
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 43));
+
+    // but only DELAY_COMMANDS different commands
+    for (int16_t i = 1; i <= 20; i++) {
+        char del[32];
+        snprintf(del, sizeof(del), "DEL 10: X %d", i);
+        char* test3[2] = { del, "X" };
+        CHECK_CALL(process_helper_state(&ss, 2, test3, 43));
+    }
+    ASSERT_EQ(ss.delay.count, DELAY_COMMANDS);
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, DELAY_COMMANDS));
+
+    // delays added by a delay are due in a later tick
+    char* script1[2] = { "X ADD X 1", "DEL 10: SCRIPT 1" };
+    CHECK_CALL(script_helper(&ss, 0, 2, script1));
+    char* test4[3] = { "X 0", "DEL 10: SCRIPT 1", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test4, 0));
+    for (int16_t i = 1; i <= 5; i++) {
+        tele_tick(&ss, 10 * TICKS_PER_MS);
+        CHECK_CALL(process_helper_state(&ss, 1, x, i));
+    }
+    ss_delays_init(&ss);
+
+    // delays longer than a lap of the wheel, across now wrapping around
+    ss.delay.now = UINT32_MAX - 500;
+    char* test5[3] = { "X 0", "DEL 1000: X 7", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test5, 0));
+    for (int16_t i = 0; i < 99; i++) tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 0));
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 7));
+
+    // DEL.CLR from a delay cancels the rest, even those due in the same tick
+    char* test6[4] = { "X 0", "DEL 10: DEL.CLR", "DEL 10: X 9", "X" };
+    CHECK_CALL(process_helper_state(&ss, 4, test6, 0));
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 0));
+    ASSERT_EQ(ss.delay.count, 0);
+
+    PASS();
+}
+
+TEST test_tick() {
+    scene_state_t ss;
+    ss_init(&ss);
+    ss.metros[0].act = false;  // see test_metro
+    char* x[1] = { "X" };
+
+    ASSERT_EQ(tele_next_deadline(&ss), TELE_NO_DEADLINE);
+
+    char* test1[3] = { "TR.TIME 1 50", "DEL 30: TR.PULSE 1", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test1, 0));
+    ASSERT_EQ(tele_next_deadline(&ss), 30 * TICKS_PER_MS);
+    tele_tick(&ss, 10 * TICKS_PER_MS);
+    ASSERT_EQ(tele_next_deadline(&ss), 20 * TICKS_PER_MS);
+
+    // a pulse started by a delay gets its full length
+    tele_tick(&ss, 20 * TICKS_PER_MS);
+    ASSERT_EQ(ss.variables.tr[0], 1);
+    ASSERT_EQ(tele_next_deadline(&ss), 50 * TICKS_PER_MS);
+    tele_tick(&ss, 50 * TICKS_PER_MS);
+    ASSERT_EQ(ss.variables.tr[0], 0);
+    ASSERT_EQ(tele_next_deadline(&ss), TELE_NO_DEADLINE);
+
+    // everything due in a long tick runs, in order, including delays added
+    // during it
+    char* script1[2] = { "X ADD X 1", "DEL 10: SCRIPT 1" };
+    CHECK_CALL(script_helper(&ss, 0, 2, script1));
+    char* test2[3] = { "X 0", "DEL 10: SCRIPT 1", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test2, 0));
+    tele_tick(&ss, 55 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 5));
+    ASSERT_EQ(tele_next_deadline(&ss), 5 * TICKS_PER_MS);
+    ss_delays_init(&ss);
+
+    PASS();
+}
+
+TEST test_tick_resolution() {
+    scene_state_t ss;
+    ss_init(&ss);
+    char* x[1] = { "X" };
+
+    // delays and pulses are timed to the tick, not to the rate tele_tick is
+    // called at
+    char* test1[4] = { "TR.TIME 1 5", "TIME 0", "DEL 15: X 1", "X" };
+    CHECK_CALL(process_helper_state(&ss, 4, test1, 0));
+    tele_tick(&ss, 15 * TICKS_PER_MS - 1);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 0));
+    tele_tick(&ss, 1);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 1));
+
+    char* test2[2] = { "TR.PULSE 1", "TR 1" };
+    CHECK_CALL(process_helper_state(&ss, 2, test2, 1));
+    ASSERT_EQ(tele_next_deadline(&ss), 5 * TICKS_PER_MS);
+    tele_tick(&ss, 5 * TICKS_PER_MS);
+    ASSERT_EQ(ss.variables.tr[0], 0);
+
+    // while TIME counts whole ms
+    char* time[1] = { "TIME" };
+    CHECK_CALL(process_helper_state(&ss, 1, time, 20));
+    tele_tick(&ss, TICKS_PER_MS / 2);
+    CHECK_CALL(process_helper_state(&ss, 1, time, 20));
+    tele_tick(&ss, TICKS_PER_MS / 2);
+    CHECK_CALL(process_helper_state(&ss, 1, time, 21));
+
+    PASS();
+}
+
+TEST test_metro() {
+    scene_state_t ss;
+    ss_init(&ss);
+    char* x[1] = { "X" };
+    char* late[1] = { "M.LATE" };
+
+    char* metro[1] = { "X ADD X 1" };
+    CHECK_CALL(script_helper(&ss, METRO_SCRIPT, 1, metro));
+    char* test1[3] = { "M 100", "M.RESET", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test1, 0));
+    ASSERT_EQ(tele_next_deadline(&ss), 100 * TICKS_PER_MS);
+
+    // uneven ticks don't cause any drift
+    for (int i = 0; i < 143; i++) tele_tick(&ss, 7 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 10));
+    ASSERT_EQ(tele_next_deadline(&ss), 99 * TICKS_PER_MS);
+
+    // a change to M takes effect from the next period
+    char* test2[2] = { "M 50", "M" };
+    CHECK_CALL(process_helper_state(&ss, 2, test2, 50));
+    ASSERT_EQ(tele_next_deadline(&ss), 99 * TICKS_PER_MS);
+    tele_tick(&ss, 99 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 11));
+    ASSERT_EQ(tele_next_deadline(&ss), 50 * TICKS_PER_MS);
+
+    // M.LATE is the most that any metro ran after it was due (how much later
+    // tele_tick was called), and a late metro doesn't delay the next one
+    CHECK_CALL(process_helper_state(&ss, 1, late, 6));
+    char* test3[2] = { "M.LATE 0", "M.LATE" };
+    CHECK_CALL(process_helper_state(&ss, 2, test3, 0));
+    tele_tick(&ss, 80 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 12));
+    CHECK_CALL(process_helper_state(&ss, 1, late, 30));
+    ASSERT_EQ(tele_next_deadline(&ss), 20 * TICKS_PER_MS);
+    tele_tick(&ss, 20 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, late, 30));
+
+    // a stopped metro has no deadline, and starts a whole period when it's
+    // started again
+    char* test4[2] = { "M.ACT 0", "X" };
+    CHECK_CALL(process_helper_state(&ss, 2, test4, 13));
+    ASSERT_EQ(tele_next_deadline(&ss), TELE_NO_DEADLINE);
+    tele_tick(&ss, 1000 * TICKS_PER_MS);
+    char* test5[2] = { "M.ACT 1", "X" };
+    CHECK_CALL(process_helper_state(&ss, 2, test5, 13));
+    ASSERT_EQ(tele_next_deadline(&ss), 50 * TICKS_PER_MS);
+
+    PASS();
+}
+
+TEST test_metros() {
+    scene_state_t ss;
+    ss_init(&ss);
+    ss.metros[0].act = false;
+
+    // M1 to M4 start off stopped, and run scripts 1 to 4
+    char* script1[1] = { "X ADD X 1" };
+    char* script5[1] = { "Y ADD Y 1" };
+    CHECK_CALL(script_helper(&ss, 0, 1, script1));
+    CHECK_CALL(script_helper(&ss, 4, 1, script5));
+    ASSERT_EQ(tele_next_deadline(&ss), TELE_NO_DEADLINE);
+    char* test1[2] = { "M1 100; M1.ACT 1", "M1.SCRIPT" };
+    CHECK_CALL(process_helper_state(&ss, 2, test1, 1));
+
+    // each runs at its own rate, so a polyrhythm needs no counting in scripts
+    char* test2[3] = { "M2 300; M2.SCRIPT 5", "M2.ACT 1", "M2.SCRIPT" };
+    CHECK_CALL(process_helper_state(&ss, 3, test2, 5));
+    for (int i = 0; i < 90; i++) tele_tick(&ss, 10 * TICKS_PER_MS);
+    char* x[1] = { "X" };
+    char* y[1] = { "Y" };
+    CHECK_CALL(process_helper_state(&ss, 1, x, 9));
+    CHECK_CALL(process_helper_state(&ss, 1, y, 3));
+
+    // and their own reset
+    tele_tick(&ss, 50 * TICKS_PER_MS);
+    char* test3[2] = { "M2.RESET", "X" };
+    CHECK_CALL(process_helper_state(&ss, 2, test3, 9));
+    ASSERT_EQ(tele_next_deadline(&ss), 50 * TICKS_PER_MS);
+    tele_tick(&ss, 50 * TICKS_PER_MS);
+    ASSERT_EQ(tele_next_deadline(&ss), 100 * TICKS_PER_MS);
+    for (int i = 0; i < 25; i++) tele_tick(&ss, 10 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 12));
+    CHECK_CALL(process_helper_state(&ss, 1, y, 4));
+
+    // they can only run scripts 1 to 8
+    char* test4[2] = { "M2.SCRIPT 9", "M2.SCRIPT" };
+    CHECK_CALL(process_helper_state(&ss, 2, test4, 5));
+
+    PASS();
+}
+
+TEST test_metro_policy() {
+    scene_state_t ss;
+    ss_init(&ss);
+    char* x[1] = { "X" };
+    char* over[1] = { "M.OVER" };
+    char* metro[1] = { "X ADD X 1" };
+    CHECK_CALL(script_helper(&ss, METRO_SCRIPT, 1, metro));
+
+    // by default missed ticks are skipped, keeping to the original timing
+    char* test1[2] = { "M 100; M.RESET", "M.POL" };
+    CHECK_CALL(process_helper_state(&ss, 2, test1, METRO_SKIP));
+    tele_tick(&ss, 350 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 1));
+    CHECK_CALL(process_helper_state(&ss, 1, over, 2));
+    ASSERT_EQ(tele_next_deadline(&ss), 50 * TICKS_PER_MS);
+
+    // or they can all be run
+    char* test2[3] = { "M.POL 1; M.OVER 0", "M.RESET; X 0", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test2, 0));
+    tele_tick(&ss, 350 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 3));
+    CHECK_CALL(process_helper_state(&ss, 1, over, 2));
+    ASSERT_EQ(tele_next_deadline(&ss), 50 * TICKS_PER_MS);
+
+    // or the metro can start a new period once it has caught up
+    char* test3[3] = { "M.POL 2; M.OVER 0", "M.RESET; X 0", "X" };
+    CHECK_CALL(process_helper_state(&ss, 3, test3, 0));
+    tele_tick(&ss, 350 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 1));
+    CHECK_CALL(process_helper_state(&ss, 1, over, 2));
+    ASSERT_EQ(tele_next_deadline(&ss), 100 * TICKS_PER_MS);
+
+    // but not when it's on time
+    tele_tick(&ss, 100 * TICKS_PER_MS);
+    CHECK_CALL(process_helper_state(&ss, 1, x, 2));
+    ASSERT_EQ(tele_next_deadline(&ss), 100 * TICKS_PER_MS);
+
+    // unknown policies are ignored
+    char* test4[2] = { "M.POL 3", "M.POL" };
+    CHECK_CALL(process_helper_state(&ss, 2, test4, METRO_THROTTLE));
+
+    PASS();
+}
+
+TEST test_II_queue() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    // only the last value set on an output is sent
+    ii_wait();
+    ii_log_clear();
+    char* test1[1] = { "TO.CV 1 100; TO.CV 1 200; 1" };
+    CHECK_CALL(process_helper_state(&ss, 1, test1, 1));
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 1);
+    ASSERT_EQ(ii_log.messages[0].addr, TO);
+    ASSERT_EQ(ii_log.messages[0].data[0], TO_CV);
+    ASSERT_EQ(ii_log.messages[0].data[3], 200);
+
+    // the set keeps its place, with the last value
+    ii_log_clear();
+    char* script1[4] = { "TO.CV 1 1", "TO.CV 2 1", "TO.CV 1 2", "TO.CV 2 3" };
+    CHECK_CALL(script_helper(&ss, 0, 4, script1));
+    run_script(&ss, 0);
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].data[1], 0);
+    ASSERT_EQ(ii_log.messages[0].data[3], 2);
+    ASSERT_EQ(ii_log.messages[1].data[1], 1);
+    ASSERT_EQ(ii_log.messages[1].data[3], 3);
+
+    // other writes are never merged, and a set after another write to the
+    // follower isn't moved before it
+    ii_log_clear();
+    char* script4[4] = { "TO.CV 1 1", "TO.TR.PULSE 1", "TO.TR.PULSE 1",
+                         "TO.CV 1 2" };
+    CHECK_CALL(script_helper(&ss, 0, 4, script4));
+    run_script(&ss, 0);
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 4);
+    ASSERT_EQ(ii_log.messages[0].data[0], TO_CV);
+    ASSERT_EQ(ii_log.messages[0].data[3], 1);
+    ASSERT_EQ(ii_log.messages[1].data[0], TO_TR_PULSE);
+    ASSERT_EQ(ii_log.messages[2].data[0], TO_TR_PULSE);
+    ASSERT_EQ(ii_log.messages[3].data[0], TO_CV);
+    ASSERT_EQ(ii_log.messages[3].data[3], 2);
+
+    // nothing is sent until the outermost script has finished
+    ii_log_clear();
+    char* script2[3] = { "TO.CV 1 3", "SCRIPT 3", "TO.CV 1 5" };
+    char* script3[1] = { "TO.CV 1 4; TO.CV 2 4" };
+    CHECK_CALL(script_helper(&ss, 1, 3, script2));
+    CHECK_CALL(script_helper(&ss, 2, 1, script3));
+    run_script(&ss, 1);
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].data[3], 5);
+    ASSERT_EQ(ii_log.messages[1].data[1], 1);
+
+    // II.FLUSH sends what has been queued so far
+    ii_log_clear();
+    char* test2[2] = { "TO.CV 1 1; II.FLUSH; TO.CV 1 2", "1" };
+    CHECK_CALL(process_helper_state(&ss, 2, test2, 1));
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].data[3], 1);
+    ASSERT_EQ(ii_log.messages[1].data[3], 2);
+
+    // as does a read, so it sees the writes before it
+    ii_log_clear();
+    char* test3[1] = { "CV 5 100; CV 5" };
+    CHECK_CALL(process_helper_state(&ss, 1, test3, 0));
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].data[0], II_ANSIBLE_CV);
+    ASSERT_EQ(ii_log.messages[1].data[0], II_ANSIBLE_CV | II_GET);
+
+    // outside of a script writes aren't held back
+    ii_log_clear();
+    uint8_t d[4] = { TO_CV, 0, 0, 1 };
+    ii_tx_set(TO, d, 4);
+    ii_tx_set(TO, d, 4);
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+
+    // a set too short to have a parameter is never merged
+    ii_log_clear();
+    ii_tx_begin(-1);
+    ii_tx_set(TO, d, 1);
+    ii_tx_set(TO, d, 1);
+    ii_tx_end();
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+
+    PASS();
+}
+
+// the ops generated from the ii entries in docs/ops/*.toml
+TEST test_II_ops() {
+    scene_state_t ss;
+    ss_init(&ss);
+    ii_wait();
+
+    // bytes and words, in the order the params are popped
+    ii_log_clear();
+    char* test1[1] = { "KR.POS 1 2 3; JF.NOTE 300 -2; 1" };
+    CHECK_CALL(process_helper_state(&ss, 1, test1, 1));
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].addr, II_KR_ADDR);
+    ASSERT_EQ(ii_log.messages[0].l, 4);
+    ASSERT_EQ(ii_log.messages[0].data[0], II_KR_POS);
+    ASSERT_EQ(ii_log.messages[0].data[3], 3);
+    ASSERT_EQ(ii_log.messages[1].addr, JF_ADDR);
+    ASSERT_EQ(ii_log.messages[1].l, 5);
+    ASSERT_EQ(ii_log.messages[1].data[1], 300 >> 8);
+    ASSERT_EQ(ii_log.messages[1].data[2], 300 & 0xff);
+    ASSERT_EQ(ii_log.messages[1].data[4], 0xfe);
+
+    // a get sends all but the last param and reads the reply
+    ii_log_clear();
+    ii_mock_response[0] = 0x01;
+    ii_mock_response[1] = 0x02;
+    char* test2[1] = { "KR.PERIOD" };
+    CHECK_CALL(process_helper_state(&ss, 1, test2, 0x0102));
+    ASSERT_EQ(ii_log.count, 1);
+    ASSERT_EQ(ii_log.messages[0].l, 1);
+    ASSERT_EQ(ii_log.messages[0].data[0], II_KR_PERIOD | II_GET);
+    ii_mock_reset();
+
+    // TELEX devices are numbered from 1, with 4 outputs each
+    ii_log_clear();
+    char* test3[1] = { "TO.M 2 100; TO.TR.P 6; 1" };
+    CHECK_CALL(process_helper_state(&ss, 1, test3, 1));
+    ii_wait();
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].addr, TO + 1);
+    ASSERT_EQ(ii_log.messages[0].data[0], TO_M);
+    ASSERT_EQ(ii_log.messages[0].data[1], 0);
+    ASSERT_EQ(ii_log.messages[0].data[3], 100);
+    ASSERT_EQ(ii_log.messages[1].addr, TO + 1);
+    ASSERT_EQ(ii_log.messages[1].l, 2);
+    ASSERT_EQ(ii_log.messages[1].data[1], 1);
+
+    // TXi inputs are read by port, PARAM knobs before IN jacks
+    ii_log_clear();
+    char* test4[1] = { "TI.PARAM.QT 2; TI.IN.N 6; 0" };
+    CHECK_CALL(process_helper_state(&ss, 1, test4, 0));
+    ASSERT_EQ(ii_log.count, 2);
+    ASSERT_EQ(ii_log.messages[0].addr, TI);
+    ASSERT_EQ(ii_log.messages[0].data[0], 1 + 8);
+    ASSERT_EQ(ii_log.messages[1].addr, TI + 1);
+    ASSERT_EQ(ii_log.messages[1].data[0], 1 + 4 + 16);
+
+    PASS();
+}
+
 TEST test_blank_command() {
     scene_state_t ss;
     ss_init(&ss);
@@ -300,11 +982,25 @@ SUITE(process_suite) {
     RUN_TEST(test_IF);
     RUN_TEST(test_FLIP);
     RUN_TEST(test_L);
+    RUN_TEST(test_L_pattern);
     RUN_TEST(test_O);
     RUN_TEST(test_P);
     RUN_TEST(test_Q);
+    RUN_TEST(test_Q_window);
     RUN_TEST(test_PN);
+    RUN_TEST(test_P_bulk);
+    RUN_TEST(test_P_BANK);
     RUN_TEST(test_X);
     RUN_TEST(test_sub_commands);
+    RUN_TEST(test_SCRIPT);
+    RUN_TEST(test_SCRIPT_inlining);
+    RUN_TEST(test_DEL);
+    RUN_TEST(test_tick);
+    RUN_TEST(test_tick_resolution);
+    RUN_TEST(test_metro);
+    RUN_TEST(test_metros);
+    RUN_TEST(test_metro_policy);
+    RUN_TEST(test_II_queue);
+    RUN_TEST(test_II_ops);
     RUN_TEST(test_blank_command);
 }
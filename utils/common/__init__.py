@@ -1,3 +1,4 @@
+from glob import glob
 from os import path
 import re
 
@@ -5,6 +6,8 @@ _THIS_FILE = path.realpath(__file__)
 _THIS_DIR = path.dirname(_THIS_FILE)
 
 OP_C = path.abspath(path.join(_THIS_DIR, "../../src/ops/op.c"))
+OPS_DIR = path.abspath(path.join(_THIS_DIR, "../../src/ops"))
+OP_DOCS_DIR = path.abspath(path.join(_THIS_DIR, "../../docs/ops"))
 
 
 def list_tele_ops():
@@ -20,6 +23,52 @@ def list_ops():
     return map(_convert_struct_name_to_op_name, list_tele_ops())
 
 
+def list_tele_op_definitions():
+    """Return a dict of the params, returns, set and pure values of every
+    struct defined with one of the MAKE_*_OP macros in src/ops, keyed on the
+    struct name"""
+    definitions = {}
+    for file_name in sorted(glob(path.join(OPS_DIR, "*.c"))):
+        with open(file_name, "r") as f:
+            src = re.sub("//.*", "", f.read())
+        for name, macro, args in re.findall(
+                r"const\s+tele_op_t\s+(op_\w+)\s*=\s*(MAKE_\w+)\s*"
+                r"\((.*?)\)\s*;", src, re.S):
+            args = [a.strip() for a in args.split(",")]
+            definitions[name] = _parse_op_definition(macro, args)
+    return definitions
+
+
+def _parse_op_definition(macro, args):
+    def is_true(s):
+        return s not in ("0", "false")
+
+    if macro == "MAKE_GET_OP":
+        return _op_definition(args[2], is_true(args[3]), False, False)
+    elif macro in ("MAKE_PURE_OP", "MAKE_PURE_ALIAS_OP"):
+        return _op_definition(args[2], is_true(args[3]), False, True)
+    elif macro in ("MAKE_GET_SET_OP", "MAKE_ALIAS_OP"):
+        return _op_definition(args[3], is_true(args[4]), args[2] != "NULL",
+                              False)
+    elif macro == "MAKE_SIMPLE_VARIABLE_OP":
+        return _op_definition(0, True, True, False)
+    elif macro == "MAKE_SIMPLE_I2C_OP":
+        return _op_definition(1, False, False, False)
+    elif macro == "MAKE_II_OP":
+        return _op_definition(args[2], is_true(args[3]), False, False)
+    elif macro == "MAKE_II_GET_SET_OP":
+        return _op_definition(args[2], True, True, False)
+    elif macro == "MAKE_METRO_OP":
+        return _op_definition(0, is_true(args[3]), args[2] != "NULL", False)
+    else:
+        raise ValueError("unknown op macro: {}".format(macro))
+
+
+def _op_definition(params, returns, has_set, pure):
+    return {"params": int(params), "returns": returns, "set": has_set,
+            "pure": pure}
+
+
 def list_tele_mods():
     """Return the names of all the structs defined in tele_mods"""
     with open(OP_C, "r") as f:
@@ -71,7 +71,7 @@ def validate_toml(ops):
             print(f" - WARNING: {name} - aliases is not an array")
 
         for k in keys - {"prototype", "prototype_set", "aliases",
-                         "short", "description"}:
+                         "short", "description", "ii"}:
             print(f" - WARNING: {name} - unknown entry - {k}")
 
 
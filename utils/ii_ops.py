@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+
+"""Generate 'src/ops/ii_ops.c' from the ii entries in 'docs/ops/*.toml'.
+
+An op that only sends a message to a follower, or sends one and reads back
+the reply, is described in its docs entry rather than written out in C, e.g.
+
+    ["KR.POS"]
+    prototype = "KR.POS x y"
+    prototype_set = "KR.POS x y z"
+    ii = { addr = "II_KR_ADDR", cmd = "II_KR_POS", layout = "byte byte byte",
+           set = true, read = 1 }
+
+addr and cmd are C expressions. layout is what follows cmd, one entry for
+each param, popped in order:
+
+    byte, word      the param as 1 byte, or 2 bytes high byte first
+    output [value]  a TELEX output, and the value to set it to (see TXSend)
+    device [value]  a TELEX device, and the value to set it to
+    input           reads a TELEX input, cmd is the TI_ command for the value
+                    (e.g. TI_IN_QT)
+
+With set = true the op is a get and set op, the set sends every param while
+the get sends all but the last with cmd | II_GET, and then reads back read
+bytes (1 or 2) which it returns.
+
+The aliases of the op share its descriptor. Only the ops in tele_ops are
+generated, and each must have an extern in one of the headers in 'src/ops'.
+"""
+
+from glob import glob
+from os import path
+import re
+
+import pytoml as toml
+
+from common import list_tele_ops, OPS_DIR, OP_DOCS_DIR
+
+II_OPS_C = path.join(OPS_DIR, "ii_ops.c")
+
+II_TX_MAX_LENGTH = 8
+
+PRE = """// clang-format off
+
+{includes}
+
+// This file has been autogenerated by 'utils/ii_ops.py' from the ii entries in
+// 'docs/ops/*.toml'
+
+"""
+
+TX_LAYOUTS = {
+    "output": "II_OP_TX_OUTPUT",
+    "device": "II_OP_TX_DEVICE",
+    "input": "II_OP_TX_INPUT"
+}
+
+
+def struct_name(op):
+    return "op_" + op.replace(".", "_")
+
+
+def list_tele_op_headers():
+    """Return the header in src/ops that declares each op, keyed on the
+    struct name"""
+    headers = {}
+    for file_name in sorted(glob(path.join(OPS_DIR, "*.h"))):
+        with open(file_name, "r") as f:
+            for name in re.findall(r"extern\s+const\s+tele_op_t\s+(op_\w+);",
+                                   f.read()):
+                headers[name] = "ops/" + path.basename(file_name)
+    return headers
+
+
+def make_descriptor(op, ii):
+    """Return the fields of the tele_ii_op_t for an op, and its params,
+    returns and set values"""
+    layout = ii["layout"].split()
+    has_set = ii.get("set", False)
+    read = ii.get("read", 0)
+
+    if layout[0] in TX_LAYOUTS:
+        if has_set or read or layout[1:] not in ([], ["value"]) or \
+                (layout[0] == "input" and len(layout) > 1):
+            raise ValueError(f"{op}: bad ii layout: {ii['layout']}")
+        if layout[0] == "input" and \
+                not re.fullmatch(r"TI_(IN|PARAM)(_QT|_N)?", str(ii["cmd"])):
+            raise ValueError(f"{op}: an input must be read with a TI_ command")
+        params = len(layout)
+        returns = layout[0] == "input"
+        fields = [ii["addr"], ii["cmd"], TX_LAYOUTS[layout[0]], params, 0, 0]
+        return fields, params, returns, False
+
+    if any(l not in ("byte", "word") for l in layout):
+        raise ValueError(f"{op}: bad ii layout: {ii['layout']}")
+    if 1 + sum(2 if l == "word" else 1 for l in layout) > II_TX_MAX_LENGTH:
+        raise ValueError(f"{op}: too long to send")
+    if has_set != (read > 0) or read not in (0, 1, 2):
+        raise ValueError(f"{op}: a get and set op must read 1 or 2 bytes")
+
+    params = len(layout) - 1 if has_set else len(layout)
+    wide = sum(1 << i for i, l in enumerate(layout) if l == "word")
+    fields = [ii["addr"], ii["cmd"], "II_OP_BYTES", params, f"0x{wide:02x}",
+              read]
+    return fields, params, has_set, has_set
+
+
+def make_ii_ops():
+    tele_ops = set(list_tele_ops())
+    headers = list_tele_op_headers()
+
+    includes = {"ii.h"}
+    descriptors = []
+    definitions = []
+
+    for file_name in sorted(glob(path.join(OP_DOCS_DIR, "*.toml"))):
+        with open(file_name, "r") as f:
+            ops = toml.load(f)
+        for op, d in ops.items():
+            if "ii" not in d:
+                continue
+            fields, params, returns, has_set = make_descriptor(op, d["ii"])
+
+            names = [op] + d.get("aliases", [])
+            names = [n for n in names if struct_name(n) in tele_ops]
+            if not names:
+                print(f" - WARNING: {op} - not in tele_ops")
+                continue
+
+            i = len(descriptors)
+            fields = ", ".join(str(f) for f in fields)
+            descriptors.append(f"    {{ {fields} }},  // {op}\n")
+
+            for n in names:
+                includes.add(headers[struct_name(n)])
+                if has_set:
+                    macro = f"MAKE_II_GET_SET_OP({n}, &ii_ops[{i}], {params})"
+                else:
+                    r = "true" if returns else "false"
+                    macro = f"MAKE_II_OP({n}, &ii_ops[{i}], {params}, {r})"
+                definitions.append(
+                    f"const tele_op_t {struct_name(n)} = {macro};\n")
+
+    output = PRE.format(includes="\n".join(
+        f'#include "{h}"' for h in sorted(includes)))
+    output += "static const tele_ii_op_t ii_ops[] = {\n"
+    output += "".join(descriptors)
+    output += "};\n\n"
+    output += "".join(definitions)
+    return output
+
+
+def main():
+    print("reading:    {}".format(OP_DOCS_DIR))
+    print("generating: {}".format(II_OPS_C))
+    output = make_ii_ops()
+    with open(II_OPS_C, "w") as g:
+        g.write(output)
+
+
+if __name__ == '__main__':
+    main()
@@ -2,11 +2,13 @@
 
 from os import path
 
-from common import list_tele_ops, list_tele_mods, OP_C
+from common import list_tele_ops, list_tele_op_definitions, list_tele_mods, \
+    OP_C
 
 THIS_FILE = path.realpath(__file__)
 THIS_DIR = path.dirname(THIS_FILE)
 OP_ENUM_H = path.abspath(path.join(THIS_DIR, "../src/ops/op_enum.h"))
+OP_TABLE_C = path.abspath(path.join(THIS_DIR, "../src/ops/op_table.c"))
 
 HEADER_PRE = """// clang-format off
 
@@ -18,6 +20,14 @@ HEADER_PRE = """// clang-format off
 """
 HEADER_POST = "#endif\n"
 
+TABLE_PRE = """// clang-format off
+
+#include "ops/op.h"
+
+// This file has been autogenerated by 'utils/op_enums.py'
+
+"""
+
 
 def make_ops():
     return [s[3:] for s in list_tele_ops()]
@@ -38,6 +48,36 @@ def make_enum(name, prefix, entries):
     return output
 
 
+def make_table(name, c_type, entries):
+    output = ""
+    output += "const {} {}[E_OP__LENGTH] = {{\n".format(c_type, name)
+    for op, e in zip(make_ops(), entries):
+        output += f"    {e},  // E_OP_{op}\n"
+    output += "};\n\n"
+    return output
+
+
+def make_flags(definition):
+    flags = []
+    if definition["returns"]:
+        flags.append("OP_FLAG_RETURNS")
+    if definition["set"]:
+        flags.append("OP_FLAG_SET")
+    if definition["pure"]:
+        flags.append("OP_FLAG_PURE")
+    return " | ".join(flags) if flags else "0"
+
+
+def make_op_table():
+    definitions = list_tele_op_definitions()
+    ops = [definitions[s] for s in list_tele_ops()]
+    params = make_table("tele_op_params", "uint8_t",
+                        [d["params"] for d in ops])
+    flags = make_table("tele_op_flags", "uint8_t",
+                       [make_flags(d) for d in ops])
+    return TABLE_PRE + params + flags
+
+
 def main():
     print("reading:    {}".format(OP_C))
     print("generating: {}".format(OP_ENUM_H))
@@ -49,6 +89,10 @@ def main():
     with open(OP_ENUM_H, "w") as g:
         g.write(header)
 
+    print("generating: {}".format(OP_TABLE_C))
+    with open(OP_TABLE_C, "w") as g:
+        g.write(make_op_table())
+
 
 if __name__ == '__main__':
     main()